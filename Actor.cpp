@@ -4,9 +4,33 @@
 #include <cmath>
 
 // Students:  Add code to this file, Actor.h, StudentWorld.h, and StudentWorld.cpp
-Actor::Actor(StudentWorld* ptrToWorld, double startX, double startY, int imageID, Direction dir, double size, unsigned int depth)
-	: GraphObject(imageID, startX, startY, dir, size, depth), m_alive(true), m_world(ptrToWorld)
+Actor::Actor(StudentWorld* ptrToWorld, double startX, double startY, int imageID, Direction dir, double size, unsigned int depth, unsigned short tags)
+	: GraphObject(imageID, startX, startY, dir, size, depth), m_alive(true), m_tags(tags), m_depth(depth), m_imageID(imageID),
+	m_world(ptrToWorld)
 {
+	m_handle.category = 0;
+	m_handle.slot = -1;
+}
+
+void* Actor::operator new(size_t size)
+{
+	return ActorPool::allocateUnpooled(size);
+}
+
+void* Actor::operator new(size_t size, ActorPool& pool)
+{
+	return pool.allocate(size);
+}
+
+void Actor::operator delete(void* p)
+{
+	ActorPool::release(p);
+}
+
+// only called when a constructor throws after new (pool) succeeded; the slot's header already knows its pool
+void Actor::operator delete(void* p, ActorPool&)
+{
+	ActorPool::release(p);
 }
 
 bool Actor::isAlive() const
@@ -14,19 +38,34 @@ bool Actor::isAlive() const
 	return m_alive;
 }
 
+unsigned short Actor::tags() const
+{
+	return m_tags;
+}
+
+int Actor::imageID() const
+{
+	return m_imageID;
+}
+
+int Actor::depth() const
+{
+	return m_depth;
+}
+
 bool Actor::isAlien() const
 {
-	return false;
+	return (m_tags & TAG_ALIEN) != 0;
 }
 
 bool Actor::isProjectile() const
 {
-	return false;
+	return (m_tags & TAG_PROJECTILE) != 0;
 }
 
 bool Actor::isGoodie() const
 {
-	return false;
+	return (m_tags & TAG_GOODIE) != 0;
 }
 
 bool Actor::isInBounds(double x, double y) const
@@ -39,12 +78,16 @@ bool Actor::isInBounds(double x, double y) const
 void Actor::setDead()
 {
 	m_alive = false;
+	m_world->actorDied(this);		// mirrors the flag into the actor store
 }
 
 void Actor::moveTo(double x, double y)
 {
 	if (isInBounds(x, y))
+	{
 		GraphObject::moveTo(x, y);
+		m_world->actorMoved(this);		// keeps the actor store and collision grid in sync
+	}
 	else
 		setDead();
 }
@@ -66,18 +109,36 @@ StudentWorld* Actor::getWorld() const
 	return m_world;
 }
 
-Star::Star(StudentWorld* ptrToWorld, double startX, double startY, double size, Direction dir, unsigned int depth, int imageID)
-	: Actor(ptrToWorld, startX, startY, IID_STAR, 0, randInt(5, 50) / 100.0, 3)
+ActorHandle Actor::handle() const
+{
+	return m_handle;
+}
+
+void Actor::setHandle(ActorHandle h)
 {
+	m_handle = h;
 }
 
-void Star::doSomething()
+void Actor::save(ActorRecord& r) const
 {
-	moveTo(getX() - 1, getY());
+	r.kind = -1;
+	r.alive = m_alive;
+	r.direction = getDirection();
+	r.x = getX();
+	r.y = getY();
+	r.size = getSize();
+}
+
+void Actor::restore(const ActorRecord& r)
+{
+	// straight to GraphObject: a saved actor may be off screen, and the world adds it to the store afterwards
+	GraphObject::moveTo(r.x, r.y);
+	setDirection(r.direction);
+	setSize(r.size);
 }
 
 Explosion::Explosion(StudentWorld* ptrToWorld, double startX, double startY)
-	: Actor(ptrToWorld, startX, startY, IID_EXPLOSION, 0, 1, 0), m_count(0)
+	: Actor(ptrToWorld, startX, startY, IID_EXPLOSION, 0, 1, 0, TAG_EXPLOSION), m_count(0)
 {
 }
 
@@ -92,9 +153,22 @@ void Explosion::doSomething()
 		setDead();
 }
 
+void Explosion::save(ActorRecord& r) const
+{
+	Actor::save(r);
+	r.kind = SPAWN_EXPLOSION;
+	r.counters[0] = m_count;
+}
+
+void Explosion::restore(const ActorRecord& r)
+{
+	Actor::restore(r);
+	m_count = r.counters[0];
+}
+
 DamageableObject::DamageableObject(StudentWorld* ptrToWorld, double startX, double startY, int imageID,
-	int startDir, double size, int depth, double hitPoints)
-	: Actor(ptrToWorld, startX, startY, imageID, startDir, size, depth), m_hitPoints(hitPoints)
+	int startDir, double size, int depth, unsigned short tags, double hitPoints)
+	: Actor(ptrToWorld, startX, startY, imageID, startDir, size, depth, tags), m_hitPoints(hitPoints)
 {
 }
 
@@ -114,8 +188,20 @@ void DamageableObject::decreaseHitPoints(double amt)
 	m_hitPoints -= amt;
 }
 
+void DamageableObject::save(ActorRecord& r) const
+{
+	Actor::save(r);
+	r.values[0] = m_hitPoints;
+}
+
+void DamageableObject::restore(const ActorRecord& r)
+{
+	Actor::restore(r);
+	m_hitPoints = r.values[0];
+}
+
 NachenBlaster::NachenBlaster(StudentWorld* ptrToWorld)
-	: DamageableObject(ptrToWorld, 0, 128, IID_NACHENBLASTER, 0, 1.0, 0, 50), m_cabbageEnergyPoints(30), m_numTorpedoes(0)
+	: DamageableObject(ptrToWorld, 0, 128, IID_NACHENBLASTER, 0, 1.0, 0, TAG_NACHENBLASTER | TAG_FACTION_NB, 50), m_cabbageEnergyPoints(30), m_numTorpedoes(0)
 {
 	
 }
@@ -153,20 +239,20 @@ void NachenBlaster::doSomething()
 		return;
 
 	int ch;
-	if (getWorld()->getKey(ch))
+	if (getWorld()->readKey(ch))
 	{
 		if (ch == KEY_PRESS_SPACE && m_cabbageEnergyPoints >= 5)
 		{
-			getWorld()->addActor(new Cabbage(getWorld(), getX() + 12, getY()));
+			getWorld()->spawnActor(SPAWN_CABBAGE, getX() + 12, getY());
 			m_cabbageEnergyPoints -= 5;
-			getWorld()->playSound(SOUND_PLAYER_SHOOT);
+			getWorld()->emitSound(SOUND_PLAYER_SHOOT);
 		}
 			
 		if (ch == KEY_PRESS_TAB && m_numTorpedoes > 0)
 		{
-			getWorld()->addActor(new Torpedo(getWorld(), getX() + 12, getY(), 0));
+			getWorld()->spawnActor(SPAWN_NB_TORPEDO, getX() + 12, getY());
 			m_numTorpedoes--;
-			getWorld()->playSound(SOUND_TORPEDO);
+			getWorld()->emitSound(SOUND_TORPEDO);
 		}
 
 		else
@@ -204,19 +290,40 @@ void NachenBlaster::increaseTorpedoes(int torpedoes)
 	m_numTorpedoes += torpedoes;
 }
 
-void NachenBlaster::sufferDamage(double amt, int cause)
+void NachenBlaster::sufferDamage(double amt, int /*cause*/)
 {
 	decreaseHitPoints(amt);
 	if (hitPoints() <= 0)
 		setDead();
 }
 
-Alien::Alien(StudentWorld* ptrToWorld, double startX, double startY, int imageID,
-	double hitPoints, double damageAmt, double deltaX,
-	double deltaY, double speed, unsigned int scoreValue)
-	: DamageableObject(ptrToWorld, startX, startY, imageID, 0, 1.5, 1, hitPoints), m_deltaX(deltaX),
-	m_deltaY(deltaY), m_damageAmt(damageAmt), m_travelSpeed(speed), m_scoreValue(scoreValue)
+void NachenBlaster::save(ActorRecord& r) const
+{
+	DamageableObject::save(r);
+	r.counters[0] = m_cabbageEnergyPoints;
+	r.counters[1] = m_numTorpedoes;
+}
+
+void NachenBlaster::restore(const ActorRecord& r)
+{
+	DamageableObject::restore(r);
+	m_cabbageEnergyPoints = r.counters[0];
+	m_numTorpedoes = r.counters[1];
+}
+
+Alien::Alien(StudentWorld* ptrToWorld, double startX, double startY, const AlienArchetype& type)
+	: DamageableObject(ptrToWorld, startX, startY, type.imageID, 0, 1.5, 1, TAG_ALIEN | TAG_FACTION_ALIEN,
+		ptrToWorld->alienLevelStats(type.kind - SPAWN_ALIEN).hitPoints),
+	m_type(&type), m_stats(&ptrToWorld->alienLevelStats(type.kind - SPAWN_ALIEN)), m_deltaX(toCoord(0)), m_deltaY(toCoord(0)),
+	m_travelSpeed(toCoord(type.speed))
 {
+	if (type.flightPlans)
+		setFlightPlan(0);		// picks its first direction on its first move
+	else
+	{
+		setFlightPlan(-1);		// -1 marks an alien that does not use flight plans
+		setTravelDirection(DOWN_LEFT);
+	}
 }
 
 void Alien::sufferDamage(double amt, int cause)
@@ -229,7 +336,7 @@ void Alien::sufferDamage(double amt, int cause)
 			killAlien();
 		}
 		else
-			getWorld()->playSound(SOUND_BLAST);
+			getWorld()->emitSound(SOUND_BLAST);
 	}
 	else if (cause == HIT_BY_SHIP)
 	{
@@ -237,29 +344,44 @@ void Alien::sufferDamage(double amt, int cause)
 	}
 }
 
+void Alien::save(ActorRecord& r) const
+{
+	// damage and score value are fixed by the archetype; hit points depend on the level it was made on
+	DamageableObject::save(r);
+	r.kind = m_type->kind;
+	r.values[1] = toDouble(m_deltaX);
+	r.values[2] = toDouble(m_deltaY);
+	r.values[3] = toDouble(m_travelSpeed);
+	r.counters[0] = m_flightPlan;
+}
+
+void Alien::restore(const ActorRecord& r)
+{
+	DamageableObject::restore(r);
+	m_deltaX = toCoord(r.values[1]);
+	m_deltaY = toCoord(r.values[2]);
+	m_travelSpeed = toCoord(r.values[3]);
+	m_flightPlan = r.counters[0];
+}
+
 void Alien::killAlien()
 {
 	getWorld()->increaseScore(getScoreValue());
 	setDead();
 	getWorld()->recordAlienDestroyed();
-	getWorld()->playSound(SOUND_DEATH);
-	getWorld()->addActor(new Explosion(getWorld(), getX(), getY()));
+	getWorld()->emitSound(SOUND_DEATH);
+	getWorld()->spawnActor(SPAWN_EXPLOSION, getX(), getY());
 	possiblyDropGoodie();
 }
 
-bool Alien::isAlien() const
-{
-	return true;
-}
-
 void Alien::setDeltaY(double dy)
 {
-	m_deltaY = dy;
+	m_deltaY = toCoord(dy);
 }
 
 void Alien::setDeltaX(double dx)
 {
-	m_deltaX = dx;
+	m_deltaX = toCoord(dx);
 }
 
 int Alien::getFlightPlan() const
@@ -291,9 +413,9 @@ void Alien::setTravelDirection(int travelDirection)
 	}
 }
 
-void Alien::setTravelSpeed(int travelSpeed)
+void Alien::setTravelSpeed(double travelSpeed)
 {
-	m_travelSpeed = travelSpeed;
+	m_travelSpeed = toCoord(travelSpeed);
 }
 
 bool Alien::isYInBounds(double y) const
@@ -313,8 +435,9 @@ void Alien::resetYBound(double& y)
 
 void Alien::move()
 {
-	double x = getX() + (m_deltaX * m_travelSpeed);
-	double y = getY() + (m_deltaY * m_travelSpeed);
+	// the step is worked out in Coord, so fixed point moves by exact integer arithmetic
+	double x = toDouble(toCoord(getX()) + (m_deltaX * m_travelSpeed));
+	double y = toDouble(toCoord(getY()) + (m_deltaY * m_travelSpeed));
 	if (!isYInBounds(y))
 		resetYBound(y);
 	moveTo(x, y);
@@ -323,24 +446,52 @@ void Alien::move()
 
 double Alien::getDamageAmt() const
 {
-	return m_damageAmt;
+	return m_type->damage;
 }
 
 int Alien::getScoreValue() const
 {
-	return m_scoreValue;
+	return m_type->scoreValue;
+}
+
+const AlienArchetype& Alien::archetype() const
+{
+	return *m_type;
+}
+
+void Alien::fire() const
+{
+	getWorld()->spawnActor(m_type->weapon, getX() - 14, getY());
+	getWorld()->emitSound(m_type->fireSound);
 }
 
-void Alien::fireTurnip() const
+bool Alien::possiblyShoot()
 {
-	getWorld()->addActor(new Turnip(getWorld(), getX() - 14, getY()));
-	getWorld()->playSound(SOUND_ALIEN_SHOOT);
+	int n = getWorld()->randInt(1, m_stats->fireRange);
+	if (n == 1)
+	{
+		fire();
+		return true;
+	}
+	if (n == 2 && m_type->ramSpeed > 0)
+	{
+		// ramming mode
+		setTravelDirection(DUE_LEFT);
+		setFlightPlan(VIEW_WIDTH);
+		setTravelSpeed(m_type->ramSpeed);
+	}
+	return false;
 }
 
-void Alien::fireTorpedo() const
+void Alien::possiblyDropGoodie() const
 {
-	getWorld()->addActor(new Torpedo(getWorld(), getX() - 14, getY(), 180));
-	getWorld()->playSound(SOUND_TORPEDO);
+	if (m_type->dropOdds == 0 || getWorld()->randInt(1, m_type->dropOdds) != 1)
+		return;
+	int goodie = m_type->drops[0];
+	if (m_type->numDrops > 1)
+		goodie = m_type->drops[getWorld()->randInt(1, m_type->numDrops) - 1];
+	getWorld()->spawnActor(goodie, getX(), getY());
+	getWorld()->emitSound(SOUND_GOODIE);
 }
 
 void Alien::doSomething()
@@ -369,9 +520,9 @@ void Alien::doSomething()
 		else if (getY() <= 0)
 			setTravelDirection(UP_LEFT);
 		else if (getFlightPlan() == 0)
-			setTravelDirection(randInt(1, 3));
+			setTravelDirection(getWorld()->randInt(1, 3));
 		if (getFlightPlan() != -1)
-			setFlightPlan(randInt(1, 32));
+			setFlightPlan(getWorld()->randInt(1, 32));
 	}
 
 	///////////////////////////////////////////////////////////////////////////////
@@ -390,101 +541,15 @@ void Alien::doSomething()
 	getWorld()->checkCollision(this);
 }
 
-Smallgon::Smallgon(StudentWorld* ptrToWorld, double startX, double startY)
-	: Alien(ptrToWorld, startX, startY, IID_SMALLGON, 5 * (1 + (ptrToWorld->getLevel() - 1) * 0.1), 5, 0, 0, 2.0, 250)
-{
-	setFlightPlan(0);
-}
-
-bool Smallgon::possiblyShoot()
-{
-	if (randInt(1, (20 / getWorld()->getLevel()) + 5) == 1)
-	{
-		fireTurnip();
-		return true;
-	}
-	return false;
-}
-
-void Smallgon::possiblyDropGoodie() const
-{
-	return;
-}
-
-Smoregon::Smoregon(StudentWorld* ptrToWorld, double startX, double startY)
-	: Alien(ptrToWorld, startX, startY, IID_SMOREGON, 5 * (1 + (ptrToWorld->getLevel() - 1) * 0.1), 5, 0, 0, 2.0, 250)
-{
-	setFlightPlan(0);
-}
-
-void Smoregon::possiblyDropGoodie() const
-{
-	if (randInt(1, 3) == 1)
-	{
-		if (randInt(1, 2) == 1)
-			getWorld()->addActor(new RepairGoodie(getWorld(), getX(), getY()));
-		else
-			getWorld()->addActor(new TorpedoGoodie(getWorld(), getX(), getY()));
-		getWorld()->playSound(SOUND_GOODIE);
-	}
-}
-
-void Smoregon::rammingMode()
-{
-	setTravelDirection(DUE_LEFT);
-	setFlightPlan(VIEW_WIDTH);
-	setTravelSpeed(5);
-}
-
-bool Smoregon::possiblyShoot() 
-{
-	int n = randInt(1, (20 / getWorld()->getLevel()) + 5);
-	if (n == 1)
-	{
-		fireTurnip();
-		return true;
-	}
-	if (n == 2)
-		rammingMode();
-	return false;
-}
-
-
-Snagglegon::Snagglegon(StudentWorld* ptrToWorld, double startX, double startY)
-	: Alien(ptrToWorld, startX, startY, IID_SNAGGLEGON, 10 * (1 + (ptrToWorld->getLevel() - 1) * 0.1), 15, -1, -1, 1.75, 1000)
-{
-	setFlightPlan(-1);		// only Snagglegons will have a "flight plan" of -1, to indicate it does not use this
-}
-
-void Snagglegon::possiblyDropGoodie() const
-{
-	if (randInt(1, 6) == 1)
-	{
-		getWorld()->addActor(new ExtraLifeGoodie(getWorld(), getX(), getY()));
-		getWorld()->playSound(SOUND_GOODIE);
-	}
-}
-
-bool Snagglegon::possiblyShoot()
-{
-	if (randInt(1, (15 / getWorld()->getLevel()) + 10) == 1)
-	{
-		fireTorpedo();
-		return true;
-	}
-	return false;
-}
-
-
-Projectile::Projectile(StudentWorld* ptrToWorld, double startX, double startY, int imageID,
+Projectile::Projectile(StudentWorld* ptrToWorld, double startX, double startY, int imageID, unsigned short tags,
 	double damageAmt, double deltaX, bool rotates, int imageDir)
-	: Actor(ptrToWorld, startX, startY, imageID, imageDir, 0.5, 1), m_rotates(rotates), m_damageAmt(damageAmt), m_deltaX(deltaX)
+	: Actor(ptrToWorld, startX, startY, imageID, imageDir, 0.5, 1, TAG_PROJECTILE | tags), m_rotates(rotates), m_damageAmt(damageAmt), m_deltaX(toCoord(deltaX))
 {
 }
 
 double Projectile::getDeltaX() const
 {
-	return m_deltaX;
+	return toDouble(m_deltaX);
 }
 
 void Projectile::doSomething()
@@ -508,9 +573,9 @@ void Projectile::doSomething()
 	// implement way to check if nachenblaster shooting or alien shooting
 	// for flatulence torpedoes (does this work?)
 	if (firedFromAlien())
-		moveTo(getX() - getDeltaX(), getY());
+		moveTo(toDouble(toCoord(getX()) - m_deltaX), getY());
 	else
-		moveTo(getX() + getDeltaX(), getY());
+		moveTo(toDouble(toCoord(getX()) + m_deltaX), getY());
 
 	if (m_rotates)
 		setDirection(getDirection() + 20);
@@ -521,40 +586,14 @@ void Projectile::doSomething()
 	getWorld()->checkCollision(this);
 }
 
-bool Projectile::isProjectile() const
-{
-	return true;
-}
-
 bool Projectile::firedFromNB() const
 {
-	if (isCabbage())
-		return true;
-	else
-		return false;
+	return (tags() & TAG_FACTION_NB) != 0;
 }
 
 bool Projectile::firedFromAlien() const
 {
-	if (isTurnip())
-		return true;
-	else
-		return false;
-}
-
-bool Projectile::isCabbage() const
-{
-	return false;
-}
-
-bool Projectile::isTurnip() const
-{
-	return false;
-}
-
-bool Projectile::isTorpedo() const
-{
-	return false;
+	return (tags() & TAG_FACTION_ALIEN) != 0;
 }
 
 double Projectile::getDmgAmt() const
@@ -563,61 +602,41 @@ double Projectile::getDmgAmt() const
 }
 
 Cabbage::Cabbage(StudentWorld* ptrToWorld, double startX, double startY)
-	: Projectile(ptrToWorld, startX, startY, IID_CABBAGE, 2, 8, true, 0)
+	: Projectile(ptrToWorld, startX, startY, IID_CABBAGE, TAG_CABBAGE | TAG_FACTION_NB, 2, 8, true, 0)
 {
 }
 
-bool Cabbage::isCabbage() const
+void Cabbage::save(ActorRecord& r) const
 {
-	return true;
+	Projectile::save(r);
+	r.kind = SPAWN_CABBAGE;
 }
 
 Turnip::Turnip(StudentWorld* ptrToWorld, double startX, double startY)
-	: Projectile(ptrToWorld, startX, startY, IID_TURNIP, 2, 6, true, 0)
+	: Projectile(ptrToWorld, startX, startY, IID_TURNIP, TAG_TURNIP | TAG_FACTION_ALIEN, 2, 6, true, 0)
 {
 }
 
-bool Turnip::isTurnip() const
+void Turnip::save(ActorRecord& r) const
 {
-	return true;
+	Projectile::save(r);
+	r.kind = SPAWN_TURNIP;
 }
 
 Torpedo::Torpedo(StudentWorld* ptrToWorld, double startX, double startY, int imageDir)
-	: Projectile(ptrToWorld, startX, startY, IID_TORPEDO, 8, 8, false, imageDir)
+	: Projectile(ptrToWorld, startX, startY, IID_TORPEDO, TAG_TORPEDO | (imageDir == 0 ? TAG_FACTION_NB : TAG_FACTION_ALIEN),
+		8, 8, false, imageDir)
 {
 }
 
-bool Torpedo::isTorpedo() const
+void Torpedo::save(ActorRecord& r) const
 {
-	return true;
-}
-
-int Torpedo::torpedoFiredFrom() const
-{
-	if (getDirection() == 0)
-		return FIRED_FROM_NB;							// shot by NachenBlaster
-	else
-		return FIRED_FROM_SNAGGLEGON;					// shot by Snagglegon
-}
-
-bool Torpedo::firedFromNB() const
-{
-	if (torpedoFiredFrom() == FIRED_FROM_NB)
-		return true;
-	else
-		return false;
-}
-
-bool Torpedo::firedFromAlien() const
-{
-	if (torpedoFiredFrom() == FIRED_FROM_SNAGGLEGON)
-		return true;
-	else
-		return false;
+	Projectile::save(r);
+	r.kind = firedFromNB() ? SPAWN_NB_TORPEDO : SPAWN_ALIEN_TORPEDO;
 }
 
 Goodie::Goodie(StudentWorld* ptrToWorld, double startX, double startY, int imageID)
-	: Actor(ptrToWorld, startX, startY, imageID, 0, 0.5, 1)
+	: Actor(ptrToWorld, startX, startY, imageID, 0, 0.5, 1, TAG_GOODIE)
 {
 }
 
@@ -649,11 +668,6 @@ void Goodie::doSomething()
 
 }
 
-bool Goodie::isGoodie() const
-{
-	return true;
-}
-
 ExtraLifeGoodie::ExtraLifeGoodie(StudentWorld* ptrToWorld, double startX, double startY)
 	: Goodie(ptrToWorld, startX, startY, IID_LIFE_GOODIE)
 {
@@ -664,6 +678,12 @@ void ExtraLifeGoodie::giveGoodie()
 	getWorld()->incLives();
 }
 
+void ExtraLifeGoodie::save(ActorRecord& r) const
+{
+	Goodie::save(r);
+	r.kind = SPAWN_EXTRA_LIFE_GOODIE;
+}
+
 RepairGoodie::RepairGoodie(StudentWorld* ptrToWorld, double startX, double startY)
 	: Goodie(ptrToWorld, startX, startY, IID_REPAIR_GOODIE)
 {
@@ -674,6 +694,12 @@ void RepairGoodie::giveGoodie()
 	getWorld()->increasePlayerHP();
 }
 
+void RepairGoodie::save(ActorRecord& r) const
+{
+	Goodie::save(r);
+	r.kind = SPAWN_REPAIR_GOODIE;
+}
+
 TorpedoGoodie::TorpedoGoodie(StudentWorld* ptrToWorld, double startX, double startY)
 	: Goodie(ptrToWorld, startX, startY, IID_TORPEDO_GOODIE)
 {
@@ -682,4 +708,10 @@ TorpedoGoodie::TorpedoGoodie(StudentWorld* ptrToWorld, double startX, double sta
 void TorpedoGoodie::giveGoodie()
 {
 	getWorld()->increaseTorpedoes();
+}
+
+void TorpedoGoodie::save(ActorRecord& r) const
+{
+	Goodie::save(r);
+	r.kind = SPAWN_TORPEDO_GOODIE;
 }
\ No newline at end of file
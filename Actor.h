@@ -2,6 +2,10 @@
 #define ACTOR_H_
 
 #include "GraphObject.h"
+#include "ActorStore.h"
+#include "ActorPool.h"
+#include "AlienArchetypes.h"
+#include "Coord.h"
 #include <iostream>
 using namespace std;
 class StudentWorld;
@@ -16,23 +20,52 @@ const int DUE_LEFT = 3;
 const int HIT_BY_SHIP = 0;
 const int HIT_BY_PROJECTILE = 1;
 
-const int ADD_SMALLGON = 1;
-const int ADD_SMOREGON = 2;
-const int ADD_SNAGGLEGON = 3;
-
-const int FIRED_FROM_NB = 1;
-const int FIRED_FROM_SNAGGLEGON = 2;
+// Actor type tags, stored inline in every Actor and set once by its constructor, so hot loops can
+// filter actors with one load and a mask instead of virtual calls
+const unsigned short TAG_EXPLOSION = 1 << 1;
+const unsigned short TAG_NACHENBLASTER = 1 << 2;
+const unsigned short TAG_ALIEN = 1 << 3;
+const unsigned short TAG_PROJECTILE = 1 << 4;
+const unsigned short TAG_GOODIE = 1 << 5;
+const unsigned short TAG_CABBAGE = 1 << 6;
+const unsigned short TAG_TURNIP = 1 << 7;
+const unsigned short TAG_TORPEDO = 1 << 8;
+const unsigned short TAG_FACTION_NB = 1 << 9;		// the NachenBlaster and everything it fires
+const unsigned short TAG_FACTION_ALIEN = 1 << 10;	// aliens and everything they fire
+
+// Fixed-size image of one actor in a StudentWorld snapshot. Every class's save() fills in what its
+// constructor cannot recreate; restore() puts it back onto an actor freshly made from kind, x and y.
+struct ActorRecord
+{
+	int kind;					// SPAWN_* that recreates the actor, -1 for the NachenBlaster
+	unsigned int serial;		// order in which the actor was added to the world
+	int alive;
+	int direction;
+	double x;
+	double y;
+	double size;
+	double values[4];			// class-specific state, see each class's save()
+	int counters[2];
+};
 
 class Actor : public GraphObject
 {
 public:
 	// Constructor
 	Actor(StudentWorld* ptrToWorld, double startX, double startY, int imageID,
-		Direction dir, double size, unsigned int depth);
+		Direction dir, double size, unsigned int depth, unsigned short tags);
 	// Destructor (virtual)
 	virtual ~Actor() {
 	}
 
+	// Actors are normally allocated from their world's pool: new (getWorld()->actorPool()) Cabbage(...), or
+	// StudentWorld::spawnActor for actors spawned by other actors. Plain new still works (the NachenBlaster
+	// uses it) and delete sends either kind back where it came from.
+	static void* operator new(size_t size);
+	static void* operator new(size_t size, ActorPool& pool);
+	static void operator delete(void* p);
+	static void operator delete(void* p, ActorPool& pool);
+
 	// pure virtual, since a general actor should not be able to "do something"
 	virtual void doSomething() = 0;
 
@@ -40,30 +73,29 @@ public:
 	bool isAlive() const;	// returns true if actor is alive
 	bool isInBounds(double x, double y) const;	// checks to see if the (x,y) coordinates are within the game boundaries
 	StudentWorld* getWorld() const;		// returns a pointer to the world the actor is in
-	virtual bool isAlien() const;		// is actor an alien?
-	virtual bool isProjectile() const;	// is actor a projectile?
-	virtual bool isGoodie() const;		// is actor a goodie?
+	unsigned short tags() const;		// TAG_* bits describing what the actor is
+	bool isAlien() const;				// is actor an alien?
+	bool isProjectile() const;			// is actor a projectile?
+	bool isGoodie() const;				// is actor a goodie?
+	ActorHandle handle() const;			// the actor's row in StudentWorld's actor store
+	int imageID() const;				// IID_* it is drawn with (GraphObject keeps its own copy private)
+	int depth() const;
+	virtual void save(ActorRecord& r) const;	// fills r with everything needed to recreate this actor
 
 	// Mutators
 	void setDead();
 	virtual void moveTo(double x, double y);		// moves actor to x, y if on screen, else does not move and marks as dead
 	void resetBounds(double& x, double &y);
+	void setHandle(ActorHandle h);
+	virtual void restore(const ActorRecord& r);	// puts back the state save() recorded
 
 private:
 	bool m_alive;
+	unsigned short m_tags;
+	unsigned char m_depth;
+	int m_imageID;
 	StudentWorld* m_world;
-};
-
-class Star : public Actor
-{
-public:
-	// Constructor
-	Star(StudentWorld* ptrToWorld, double startX, double startY, double size, Direction dir = 0, unsigned int depth = 3, int imageID = IID_STAR);
-	// Destructor
-	virtual ~Star() {
-	}
-	//Mutators
-	virtual void doSomething();
+	ActorHandle m_handle;
 };
 
 class Explosion : public Actor
@@ -71,6 +103,8 @@ class Explosion : public Actor
 public:
 	Explosion(StudentWorld* ptrToWorld, double startX, double startY);
 	virtual void doSomething();
+	virtual void save(ActorRecord& r) const;
+	virtual void restore(const ActorRecord& r);
 private:
 	int m_count;			// will keep track of how many ticks the star has been alive in
 };
@@ -80,7 +114,7 @@ class DamageableObject : public Actor
 public:
 	// Constructor
 	DamageableObject(StudentWorld* ptrToWorld, double startX, double startY, int imageID,
-		int startDir, double size, int depth, double hitPoints);
+		int startDir, double size, int depth, unsigned short tags, double hitPoints);
 
 	// How many hit points does this actor have left?
 	double hitPoints() const;
@@ -93,6 +127,9 @@ public:
 	// a ship or a projectile (see constants above).
 	virtual void sufferDamage(double amt, int cause) = 0;
 
+	virtual void save(ActorRecord& r) const;
+	virtual void restore(const ActorRecord& r);
+
 private:
 	double m_hitPoints;
 };
@@ -112,6 +149,8 @@ public:
 	virtual void doSomething();
 	void increaseTorpedoes(int torpedoes);
 	virtual void sufferDamage(double amt, int cause);
+	virtual void save(ActorRecord& r) const;
+	virtual void restore(const ActorRecord& r);
 
 private:
 	void move(const int dir, double x, double y);
@@ -123,27 +162,26 @@ class Alien : public DamageableObject
 {
 public:
 	// Constructor
-	Alien(StudentWorld* ptrToWorld, double startX, double startY, int imageID,
-		double hitPoints, double damageAmt, double deltaX,
-		double deltaY, double speed, unsigned int scoreValue);
+	Alien(StudentWorld* ptrToWorld, double startX, double startY, const AlienArchetype& type);
 
 	virtual void doSomething();
-	virtual bool isAlien() const;
 	virtual void sufferDamage(double amt, int cause);
 
 	// Accessors
 	double getDamageAmt() const;
 	int getScoreValue() const;
+	const AlienArchetype& archetype() const;
 
 	// Mutators
 	void setFlightPlan(int flightPlan);
 	void setTravelDirection(int travelDirection);
-	void setTravelSpeed(int travelSpeed);
+	void setTravelSpeed(double travelSpeed);
 	
-	virtual bool possiblyShoot() = 0;		// tells alien to shoot
-	void fireTurnip() const;				
-	void fireTorpedo() const;
-	virtual void possiblyDropGoodie() const = 0;				// if alien drops goodies, drop one with appropriate probability
+	bool possiblyShoot();				// tells alien to shoot, or maybe to start ramming
+	void fire() const;					// fires the archetype's weapon
+	void possiblyDropGoodie() const;	// if alien drops goodies, drop one with appropriate probability
+	virtual void save(ActorRecord& r) const;
+	virtual void restore(const ActorRecord& r);
 
 private:
 	// private methods
@@ -156,89 +194,53 @@ private:
 	void move();		// moves player by current speed in direction indicated by x and y deltas
 	
 	// private member variables
-	int m_flightPlan;			// only Smallgons and Smoregons use this! for Snagglegons, it will be set to -1
-	double m_deltaX;
-	double m_deltaY;
-	double m_damageAmt;
-	double m_travelSpeed;
-	int m_scoreValue;
-};
-
-class Smallgon : public Alien
-{
-public:
-	// Constructor
-	Smallgon(StudentWorld* ptrToWorld, double startX, double startY);
-	virtual bool possiblyShoot();
-	virtual void possiblyDropGoodie() const;
-};
-
-class Smoregon : public Alien
-{
-public:
-	// Constructor
-	Smoregon(StudentWorld* ptrToWorld, double startX, double startY);
-	virtual void possiblyDropGoodie() const;
-	virtual bool possiblyShoot();
-private:
-	void rammingMode();
-};
-
-class Snagglegon : public Alien
-{
-public:
-	Snagglegon(StudentWorld* ptrToWorld, double startX, double startY);
-	virtual void possiblyDropGoodie() const;
-	virtual bool possiblyShoot();
+	const AlienArchetype* m_type;		// owned by the world's AlienArchetypes
+	const AlienLevelStats* m_stats;		// the world's numbers for m_type on this level
+	int m_flightPlan;			// only archetypes with flight plans use this! for the others, it will be set to -1
+	Coord m_deltaX;
+	Coord m_deltaY;
+	Coord m_travelSpeed;
 };
 
 class Projectile : public Actor
 {
 public:
-	Projectile(StudentWorld* ptrToWorld, double startX, double startY, int imageID,
+	Projectile(StudentWorld* ptrToWorld, double startX, double startY, int imageID, unsigned short tags,
 		double damageAmt, double deltaX, bool rotates, int imageDir);
 	virtual void doSomething();
-	virtual bool isProjectile() const;
-	virtual bool firedFromNB() const;
-	virtual bool firedFromAlien() const;
+	bool firedFromNB() const;
+	bool firedFromAlien() const;
 
 	// Accessor
 	
 	double getDmgAmt() const;
 
 private:
-	virtual bool isCabbage() const;
-	virtual bool isTurnip() const;
-	virtual bool isTorpedo() const;
 	double getDeltaX() const;
 	bool m_rotates;
 	double m_damageAmt;
-	double m_deltaX;
+	Coord m_deltaX;
 };
 
 class Cabbage : public Projectile
 {
 public:
 	Cabbage(StudentWorld* ptrToWorld, double startX, double startY);
-	virtual bool isCabbage() const;
+	virtual void save(ActorRecord& r) const;
 };
 
 class Turnip : public Projectile
 {
 public: 
 	Turnip(StudentWorld* ptrToWorld, double startX, double startY);
-	virtual bool isTurnip() const;
+	virtual void save(ActorRecord& r) const;
 };
 
 class Torpedo : public Projectile
 {
 public:
-	Torpedo(StudentWorld* ptrToWorld, double startX, double startY, int imageDir);
-	virtual bool isTorpedo() const;
-	virtual bool firedFromNB() const;
-	virtual bool firedFromAlien() const;
-private:
-	int torpedoFiredFrom() const;
+	Torpedo(StudentWorld* ptrToWorld, double startX, double startY, int imageDir);		// imageDir 0 is fired by the NachenBlaster, 180 by a Snagglegon
+	virtual void save(ActorRecord& r) const;
 };
 
 class Goodie : public Actor
@@ -247,7 +249,6 @@ public:
 	Goodie(StudentWorld* ptrToWorld, double startX, double startY, int imageID);
 	virtual void doSomething();
 	virtual void giveGoodie() = 0;
-	virtual bool isGoodie() const;
 };
 
 class ExtraLifeGoodie : public Goodie
@@ -255,6 +256,7 @@ class ExtraLifeGoodie : public Goodie
 public:
 	ExtraLifeGoodie(StudentWorld* ptrToWorld, double startX, double startY);
 	virtual void giveGoodie();
+	virtual void save(ActorRecord& r) const;
 };
 
 class RepairGoodie : public Goodie
@@ -262,6 +264,7 @@ class RepairGoodie : public Goodie
 public:
 	RepairGoodie(StudentWorld* ptrToWorld, double startX, double startY);
 	virtual void giveGoodie();
+	virtual void save(ActorRecord& r) const;
 };
 
 class TorpedoGoodie : public Goodie
@@ -269,6 +272,7 @@ class TorpedoGoodie : public Goodie
 public:
 	TorpedoGoodie(StudentWorld* ptrToWorld, double startX, double startY);
 	virtual void giveGoodie();
+	virtual void save(ActorRecord& r) const;
 };
 
 #endif // ACTOR_H_
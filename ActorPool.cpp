@@ -0,0 +1,126 @@
+#include "ActorPool.h"
+#include <new>
+using namespace std;
+
+namespace
+{
+	const size_t ALIGNMENT = alignof(max_align_t);
+	const size_t HEADER_SIZE = (sizeof(ActorPool*) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+	ActorPool*& ownerOf(void* p)
+	{
+		return *reinterpret_cast<ActorPool**>(static_cast<char*>(p) - HEADER_SIZE);
+	}
+}
+
+ActorPool::ActorPool(size_t slotSize, size_t slotsPerChunk)
+	: m_slotSize(slotSize), m_stride(HEADER_SIZE + (slotSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT),
+	m_slotsPerChunk(slotsPerChunk), m_heapAllocations(0), m_liveObjects(0), m_recycledObjects(0), m_untouchedSlots(0)
+{
+}
+
+ActorPool::~ActorPool()
+{
+	for (vector<char*>::iterator p = m_chunks.begin(); p != m_chunks.end(); p++)
+		::operator delete(*p);
+}
+
+size_t ActorPool::slotSize() const
+{
+	return m_slotSize;
+}
+
+size_t ActorPool::heapAllocations() const
+{
+	return m_heapAllocations;
+}
+
+size_t ActorPool::liveObjects() const
+{
+	return m_liveObjects;
+}
+
+size_t ActorPool::recycledObjects() const
+{
+	return m_recycledObjects;
+}
+
+size_t ActorPool::capacity() const
+{
+	return m_chunks.size() * m_slotsPerChunk;
+}
+
+void ActorPool::addChunk()
+{
+	char* chunk = static_cast<char*>(::operator new(m_stride * m_slotsPerChunk));
+	m_chunks.push_back(chunk);
+	m_heapAllocations++;
+	m_untouchedSlots = m_slotsPerChunk;		// only called when the free list is empty
+
+	// push in reverse so slots are handed out front to back
+	m_freeSlots.reserve(capacity());
+	for (size_t i = m_slotsPerChunk; i > 0; i--)
+		m_freeSlots.push_back(chunk + (i - 1) * m_stride + HEADER_SIZE);
+}
+
+void* ActorPool::allocate(size_t size)
+{
+	if (size > m_slotSize)
+		return allocateUnpooled(size);
+
+	if (m_freeSlots.empty())
+		addChunk();
+
+	// freed slots sit on top of the never-used ones, so anything above them is a recycled slot
+	if (m_freeSlots.size() > m_untouchedSlots)
+		m_recycledObjects++;
+	else
+		m_untouchedSlots--;
+
+	void* p = m_freeSlots.back();
+	m_freeSlots.pop_back();
+	ownerOf(p) = this;
+	m_liveObjects++;
+	return p;
+}
+
+void ActorPool::releaseSlot(void* p)
+{
+	m_freeSlots.push_back(p);
+	m_liveObjects--;
+}
+
+void ActorPool::releaseAll(const vector<void*>& slots)
+{
+	// addChunk keeps m_freeSlots' capacity at capacity(), so none of these pushes reallocates
+	size_t released = 0;
+	for (vector<void*>::const_iterator p = slots.begin(); p != slots.end(); p++)
+	{
+		if (ownerOf(*p) == this)
+		{
+			m_freeSlots.push_back(*p);
+			released++;
+		}
+		else
+			release(*p);
+	}
+	m_liveObjects -= released;
+}
+
+void* ActorPool::allocateUnpooled(size_t size)
+{
+	void* p = static_cast<char*>(::operator new(HEADER_SIZE + size)) + HEADER_SIZE;
+	ownerOf(p) = nullptr;
+	return p;
+}
+
+void ActorPool::release(void* p)
+{
+	if (p == nullptr)
+		return;
+	ActorPool* owner = ownerOf(p);
+	if (owner != nullptr)
+		owner->releaseSlot(p);
+	else
+		::operator delete(static_cast<char*>(p) - HEADER_SIZE);
+}
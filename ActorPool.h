@@ -0,0 +1,58 @@
+#ifndef ACTORPOOL_H_
+#define ACTORPOOL_H_
+
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+// Fixed-size object pool for actors. Every slot is big enough for the largest pooled Actor subclass,
+// so one pool serves cabbages, turnips, torpedoes, explosions, goodies and aliens alike.
+// Memory is carved out of chunks that are only returned to the heap when the pool is destroyed;
+// released slots go on a free list and are handed out again, so once a level has reached its
+// high-water mark of live actors, spawning and deleting actors never touches the heap.
+//
+// Each slot starts with a small header naming the pool that owns it (or nullptr for memory that came
+// straight from the heap), which lets Actor::operator delete send any actor back where it came from.
+class ActorPool
+{
+public:
+	// Constructor
+	ActorPool(size_t slotSize, size_t slotsPerChunk = 64);
+	// Destructor
+	~ActorPool();
+
+	// Accessors
+	size_t slotSize() const;
+	size_t heapAllocations() const;		// number of times the pool has gone to the heap for a new chunk
+	size_t liveObjects() const;			// slots currently handed out
+	size_t recycledObjects() const;		// allocations served from the free list
+	size_t capacity() const;			// total slots across all chunks
+
+	// Mutators
+	void* allocate(size_t size);		// size must be <= slotSize()
+
+	// works for memory from any pool as well as from allocateUnpooled
+	static void* allocateUnpooled(size_t size);
+	static void release(void* p);
+	void releaseAll(const vector<void*>& slots);		// release on each, with one pass for the slots that are this pool's
+
+private:
+	// no copying: slots point back at their pool
+	ActorPool(const ActorPool&);
+	ActorPool& operator=(const ActorPool&);
+
+	void addChunk();
+	void releaseSlot(void* p);
+
+	size_t m_slotSize;
+	size_t m_stride;					// header + slot, rounded up to keep every slot aligned
+	size_t m_slotsPerChunk;
+	vector<char*> m_chunks;
+	vector<void*> m_freeSlots;			// LIFO, so the most recently freed (cache-warm) slot is reused first
+	size_t m_heapAllocations;
+	size_t m_liveObjects;
+	size_t m_recycledObjects;
+	size_t m_untouchedSlots;			// slots at the bottom of m_freeSlots that have never been handed out
+};
+
+#endif // ACTORPOOL_H_
@@ -0,0 +1,174 @@
+#include "ActorStore.h"
+#include "Actor.h"
+using namespace std;
+
+int categoryOf(unsigned short tags)
+{
+	if (tags & TAG_ALIEN)
+		return CATEGORY_ALIEN;
+	if (tags & TAG_PROJECTILE)
+		return (tags & TAG_FACTION_NB) ? CATEGORY_NB_PROJECTILE : CATEGORY_ALIEN_PROJECTILE;
+	if (tags & TAG_GOODIE)
+		return CATEGORY_GOODIE;
+	return CATEGORY_EXPLOSION;
+}
+
+ActorStore::ActorStore()
+{
+	// a busy moment can hold more actors of a category than any before it; with room set aside, that
+	// only reallocates the columns in the middle of a tick when it is far busier than usual
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+	{
+		ActorColumns& c = m_columns[i];
+		c.x.reserve(STORE_CATEGORY_RESERVE);
+		c.y.reserve(STORE_CATEGORY_RESERVE);
+		c.radius.reserve(STORE_CATEGORY_RESERVE);
+		c.alive.reserve(STORE_CATEGORY_RESERVE);
+		c.tags.reserve(STORE_CATEGORY_RESERVE);
+		c.serial.reserve(STORE_CATEGORY_RESERVE);
+		c.cell.reserve(STORE_CATEGORY_RESERVE);
+		c.actor.reserve(STORE_CATEGORY_RESERVE);
+		c.slot.reserve(STORE_CATEGORY_RESERVE);
+		m_rowOfSlot[i].reserve(STORE_CATEGORY_RESERVE);
+		m_freeSlots[i].reserve(STORE_CATEGORY_RESERVE);
+	}
+}
+
+const ActorColumns& ActorStore::columns(int category) const
+{
+	return m_columns[category];
+}
+
+int ActorStore::size(int category) const
+{
+	return m_columns[category].actor.size();
+}
+
+int ActorStore::indexOf(ActorHandle h) const
+{
+	return m_rowOfSlot[h.category][h.slot];
+}
+
+bool ActorStore::isAlive(ActorHandle h) const
+{
+	return m_columns[h.category].alive[indexOf(h)] != 0;
+}
+
+unsigned short ActorStore::tagsOf(ActorHandle h) const
+{
+	return m_columns[h.category].tags[indexOf(h)];
+}
+
+int ActorStore::cellOf(ActorHandle h) const
+{
+	return m_columns[h.category].cell[indexOf(h)];
+}
+
+Actor* ActorStore::actorAt(ActorHandle h) const
+{
+	return m_columns[h.category].actor[indexOf(h)];
+}
+
+ActorHandle ActorStore::add(Actor* a, unsigned int serial)
+{
+	ActorHandle h;
+	h.category = categoryOf(a->tags());
+
+	// reuse a free slot if there is one, so the slot table does not keep growing
+	vector<int>& freeSlots = m_freeSlots[h.category];
+	vector<int>& rowOfSlot = m_rowOfSlot[h.category];
+	if (!freeSlots.empty())
+	{
+		h.slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		h.slot = rowOfSlot.size();
+		rowOfSlot.push_back(-1);
+	}
+
+	ActorColumns& c = m_columns[h.category];
+	rowOfSlot[h.slot] = c.actor.size();
+	c.x.push_back(toCoord(a->getX()));
+	c.y.push_back(toCoord(a->getY()));
+	c.radius.push_back(toCoord(a->getRadius()));
+	c.alive.push_back(a->isAlive());
+	c.tags.push_back(a->tags());
+	c.serial.push_back(serial);
+	c.cell.push_back(-1);
+	c.actor.push_back(a);
+	c.slot.push_back(h.slot);
+	return h;
+}
+
+void ActorStore::remove(ActorHandle h)
+{
+	ActorColumns& c = m_columns[h.category];
+	int row = indexOf(h);
+	int last = c.actor.size() - 1;
+
+	// move the last row into the hole so the columns stay dense
+	if (row != last)
+	{
+		c.x[row] = c.x[last];
+		c.y[row] = c.y[last];
+		c.radius[row] = c.radius[last];
+		c.alive[row] = c.alive[last];
+		c.tags[row] = c.tags[last];
+		c.serial[row] = c.serial[last];
+		c.cell[row] = c.cell[last];
+		c.actor[row] = c.actor[last];
+		c.slot[row] = c.slot[last];
+		m_rowOfSlot[h.category][c.slot[row]] = row;
+	}
+	c.x.pop_back();
+	c.y.pop_back();
+	c.radius.pop_back();
+	c.alive.pop_back();
+	c.tags.pop_back();
+	c.serial.pop_back();
+	c.cell.pop_back();
+	c.actor.pop_back();
+	c.slot.pop_back();
+
+	m_rowOfSlot[h.category][h.slot] = -1;
+	m_freeSlots[h.category].push_back(h.slot);
+}
+
+void ActorStore::setPosition(ActorHandle h, double x, double y)
+{
+	int row = indexOf(h);
+	m_columns[h.category].x[row] = toCoord(x);
+	m_columns[h.category].y[row] = toCoord(y);
+}
+
+void ActorStore::setDead(ActorHandle h)
+{
+	m_columns[h.category].alive[indexOf(h)] = false;
+}
+
+void ActorStore::setCell(ActorHandle h, int cell)
+{
+	m_columns[h.category].cell[indexOf(h)] = cell;
+}
+
+void ActorStore::clear()
+{
+	// clear() keeps capacity, so the next level does not reallocate
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+	{
+		ActorColumns& c = m_columns[i];
+		c.x.clear();
+		c.y.clear();
+		c.radius.clear();
+		c.alive.clear();
+		c.tags.clear();
+		c.serial.clear();
+		c.cell.clear();
+		c.actor.clear();
+		c.slot.clear();
+		m_rowOfSlot[i].clear();
+		m_freeSlots[i].clear();
+	}
+}
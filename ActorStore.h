@@ -0,0 +1,79 @@
+#ifndef ACTORSTORE_H_
+#define ACTORSTORE_H_
+
+#include "Coord.h"
+#include <vector>
+using namespace std;
+
+class Actor;
+
+const int STORE_CATEGORY_RESERVE = 64;		// rows each category has room for before its columns have to grow
+
+// Categories the store partitions actors into; each one keeps its own contiguous columns.
+// Projectiles are split by who fired them, since each side only ever collides with the other.
+enum ActorCategory
+{
+	CATEGORY_ALIEN,
+	CATEGORY_NB_PROJECTILE,
+	CATEGORY_ALIEN_PROJECTILE,
+	CATEGORY_GOODIE,
+	CATEGORY_EXPLOSION,
+	NUM_CATEGORIES
+};
+
+int categoryOf(unsigned short tags);		// which category an actor with these TAG_* bits is stored in
+
+// Stable reference to an actor's row in the store; stays valid while other rows are added and removed
+struct ActorHandle
+{
+	int category;
+	int slot;		// -1 if the actor is not in a store
+};
+
+// Dense, structure-of-arrays columns for one category. Row i of every column describes the same actor.
+struct ActorColumns
+{
+	vector<Coord> x;
+	vector<Coord> y;
+	vector<Coord> radius;			// fixed at insertion; only explosions change size and they never collide
+	vector<char> alive;
+	vector<unsigned short> tags;	// copy of Actor::tags(), so filters never touch the actor
+	vector<unsigned int> serial;	// order in which the actor was added to the world
+	vector<int> cell;				// collision grid cell, -1 if the actor is not in the grid
+	vector<Actor*> actor;
+	vector<int> slot;				// row -> slot, the inverse of ActorStore's slot table
+};
+
+// Type-partitioned actor storage. Collision and bookkeeping loops stream through the columns of the
+// category they care about instead of chasing an Actor* per node. Movement does not: actors move in their
+// own doSomething and Actor::moveTo mirrors the result here (see StudentWorld::tick).
+class ActorStore
+{
+public:
+	// Constructor
+	ActorStore();
+
+	// Accessors
+	const ActorColumns& columns(int category) const;
+	int size(int category) const;
+	int indexOf(ActorHandle h) const;		// current row of h within its category's columns
+	bool isAlive(ActorHandle h) const;
+	unsigned short tagsOf(ActorHandle h) const;
+	int cellOf(ActorHandle h) const;
+	Actor* actorAt(ActorHandle h) const;
+
+	// Mutators
+	ActorHandle add(Actor* a, unsigned int serial);
+	void remove(ActorHandle h);				// moves the last row of the category into h's row
+	void setPosition(ActorHandle h, double x, double y);
+	void setDead(ActorHandle h);
+	void setCell(ActorHandle h, int cell);
+	void clear();
+
+private:
+	ActorColumns m_columns[NUM_CATEGORIES];
+	vector<int> m_rowOfSlot[NUM_CATEGORIES];	// slot -> current row, -1 for free slots
+	vector<int> m_freeSlots[NUM_CATEGORIES];
+};
+
+#endif // ACTORSTORE_H_
@@ -0,0 +1,216 @@
+#include "AlienArchetypes.h"
+#include "StudentWorld.h"
+#include "GameConstants.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+using namespace std;
+
+AlienArchetype::AlienArchetype()
+	: kind(SPAWN_ALIEN), imageID(IID_SMALLGON), hitPoints(1), hitPointsPerLevel(0), damage(0), speed(0), scoreValue(0),
+	flightPlans(true), weapon(SPAWN_TURNIP), fireSound(SOUND_ALIEN_SHOOT), fireNumerator(0), fireBase(1), ramSpeed(0), dropOdds(0), numDrops(0),
+	weight(0), weightPerLevel(0)
+{
+	for (int i = 0; i < MAX_ALIEN_DROPS; i++)
+		drops[i] = SPAWN_REPAIR_GOODIE;
+}
+
+// the original three aliens, in the order decideShipToAdd has always listed them
+AlienArchetypes::AlienArchetypes()
+{
+	AlienArchetype smallgon;
+	smallgon.name = "smallgon";
+	smallgon.imageID = IID_SMALLGON;
+	smallgon.hitPoints = 5;
+	smallgon.hitPointsPerLevel = .1;
+	smallgon.damage = 5;
+	smallgon.speed = 2.0;
+	smallgon.scoreValue = 250;
+	smallgon.weapon = SPAWN_TURNIP;
+	smallgon.fireNumerator = 20;
+	smallgon.fireBase = 5;
+	smallgon.weight = 60;
+	add(smallgon);
+
+	AlienArchetype smoregon = smallgon;
+	smoregon.name = "smoregon";
+	smoregon.imageID = IID_SMOREGON;
+	smoregon.ramSpeed = 5;
+	smoregon.dropOdds = 3;
+	smoregon.numDrops = 2;
+	smoregon.drops[0] = SPAWN_REPAIR_GOODIE;
+	smoregon.drops[1] = SPAWN_TORPEDO_GOODIE;
+	smoregon.weight = 20;
+	smoregon.weightPerLevel = 5;
+	add(smoregon);
+
+	AlienArchetype snagglegon;
+	snagglegon.name = "snagglegon";
+	snagglegon.imageID = IID_SNAGGLEGON;
+	snagglegon.hitPoints = 10;
+	snagglegon.hitPointsPerLevel = .1;
+	snagglegon.damage = 15;
+	snagglegon.speed = 1.75;
+	snagglegon.scoreValue = 1000;
+	snagglegon.flightPlans = false;
+	snagglegon.weapon = SPAWN_ALIEN_TORPEDO;
+	snagglegon.fireNumerator = 15;
+	snagglegon.fireBase = 10;
+	snagglegon.dropOdds = 6;
+	snagglegon.numDrops = 1;
+	snagglegon.drops[0] = SPAWN_EXTRA_LIFE_GOODIE;
+	snagglegon.weight = 5;
+	snagglegon.weightPerLevel = 10;
+	add(snagglegon);
+}
+
+int AlienArchetypes::size() const
+{
+	return m_archetypes.size();
+}
+
+const AlienArchetype& AlienArchetypes::get(int i) const
+{
+	return m_archetypes[i];
+}
+
+// FNV-1a over the bytes of one field at a time, so struct padding never gets in
+template <typename T>
+static void hashField(uint64_t& h, const T& value)
+{
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(&value);
+	for (size_t i = 0; i < sizeof(value); i++)
+		h = (h ^ p[i]) * 1099511628211ULL;
+}
+
+uint32_t AlienArchetypes::hash() const
+{
+	uint64_t h = 14695981039346656037ULL;
+	for (size_t i = 0; i < m_archetypes.size(); i++)
+	{
+		const AlienArchetype& a = m_archetypes[i];
+		for (size_t c = 0; c < a.name.size(); c++)
+			hashField(h, a.name[c]);
+		hashField(h, a.name.size());
+		hashField(h, a.imageID);
+		hashField(h, a.hitPoints);
+		hashField(h, a.hitPointsPerLevel);
+		hashField(h, a.damage);
+		hashField(h, a.speed);
+		hashField(h, a.scoreValue);
+		hashField(h, a.flightPlans);
+		hashField(h, a.weapon);
+		hashField(h, a.fireNumerator);
+		hashField(h, a.fireBase);
+		hashField(h, a.ramSpeed);
+		hashField(h, a.dropOdds);
+		hashField(h, a.numDrops);
+		for (int d = 0; d < a.numDrops; d++)
+			hashField(h, a.drops[d]);
+		hashField(h, a.weight);
+		hashField(h, a.weightPerLevel);
+	}
+	return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+void AlienArchetypes::add(const AlienArchetype& a)
+{
+	m_archetypes.push_back(a);
+	m_archetypes.back().kind = SPAWN_ALIEN + m_archetypes.size() - 1;
+	m_archetypes.back().fireSound = a.weapon == SPAWN_TURNIP ? SOUND_ALIEN_SHOOT : SOUND_TORPEDO;
+}
+
+// names the file uses for sprites, weapons and goodies
+static bool parseSprite(const string& s, int& imageID)
+{
+	if (s == "smallgon")
+		imageID = IID_SMALLGON;
+	else if (s == "smoregon")
+		imageID = IID_SMOREGON;
+	else if (s == "snagglegon")
+		imageID = IID_SNAGGLEGON;
+	else
+		return false;
+	return true;
+}
+
+static bool parseWeapon(const string& s, int& weapon)
+{
+	if (s == "turnip")
+		weapon = SPAWN_TURNIP;
+	else if (s == "torpedo")
+		weapon = SPAWN_ALIEN_TORPEDO;
+	else
+		return false;
+	return true;
+}
+
+static bool parseDrops(const string& s, AlienArchetype& a)
+{
+	a.numDrops = 0;
+	if (s == "-")
+		return true;
+	istringstream names(s);
+	string name;
+	while (getline(names, name, ','))
+	{
+		if (a.numDrops == MAX_ALIEN_DROPS)
+			return false;
+		if (name == "repair")
+			a.drops[a.numDrops++] = SPAWN_REPAIR_GOODIE;
+		else if (name == "torpedo")
+			a.drops[a.numDrops++] = SPAWN_TORPEDO_GOODIE;
+		else if (name == "extralife")
+			a.drops[a.numDrops++] = SPAWN_EXTRA_LIFE_GOODIE;
+		else
+			return false;
+	}
+	return a.numDrops > 0;
+}
+
+// Coord.h's float and 16.16 builds only play the same game as the double one if every step is a multiple of .25
+static bool isQuarterStep(double v)
+{
+	return floor(v * 4) == v * 4;
+}
+
+bool AlienArchetypes::load(const string& path)
+{
+	ifstream in(path.c_str());
+	if (!in)
+		return false;
+
+	// parse into a fresh table, so a bad file leaves this one alone
+	AlienArchetypes table;
+	table.m_archetypes.clear();
+	long totalWeight = 0;
+	string line;
+	while (getline(in, line))
+	{
+		istringstream fields(line);
+		AlienArchetype a;
+		string sprite, flightPlans, weapon, drops, extra;
+		if (!(fields >> a.name) || a.name[0] == '#')
+			continue;		// blank line or comment
+		if (!(fields >> sprite >> a.hitPoints >> a.hitPointsPerLevel >> a.damage >> a.speed >> a.scoreValue >> flightPlans
+			>> weapon >> a.fireNumerator >> a.fireBase >> a.ramSpeed >> a.dropOdds >> drops >> a.weight >> a.weightPerLevel) || fields >> extra)
+			return false;
+		if (!parseSprite(sprite, a.imageID) || !parseWeapon(weapon, a.weapon) || !parseDrops(drops, a))
+			return false;
+		if (flightPlans != "yes" && flightPlans != "no")
+			return false;
+		a.flightPlans = flightPlans == "yes";
+		if (a.hitPoints <= 0 || a.speed <= 0 || a.fireNumerator < 0 || a.fireBase < 1 || a.ramSpeed < 0 || a.dropOdds < 0 ||
+			(a.dropOdds > 0 && a.numDrops == 0) || a.weight < 0 || a.weightPerLevel < 0)
+			return false;
+		if (!isQuarterStep(a.speed) || !isQuarterStep(a.ramSpeed))
+			return false;
+		table.add(a);
+		totalWeight += a.weight + a.weightPerLevel;
+	}
+	if (totalWeight == 0)		// no archetypes, or none decideShipToAdd could ever pick
+		return false;
+
+	m_archetypes = table.m_archetypes;
+	return true;
+}
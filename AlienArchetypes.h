@@ -0,0 +1,68 @@
+#ifndef ALIENARCHETYPES_H_
+#define ALIENARCHETYPES_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+const int MAX_ALIEN_DROPS = 4;		// goodie kinds one archetype can choose between
+
+// Everything that makes one kind of alien different from another. Aliens keep a pointer to their
+// archetype and Alien's one update path reads it, so a new kind of alien is a new row, not a new class.
+struct AlienArchetype
+{
+	AlienArchetype();
+	string name;
+	int kind;					// SPAWN_ALIEN + row; set by AlienArchetypes
+	int imageID;
+	double hitPoints;			// on level 1; hitPoints * (1 + (level - 1) * hitPointsPerLevel) on later levels
+	double hitPointsPerLevel;
+	double damage;				// done to the NachenBlaster by ramming it
+	double speed;
+	int scoreValue;
+	bool flightPlans;			// picks a random direction and distance whenever its flight plan runs out; otherwise starts down-left and only bounces
+	int weapon;					// SPAWN_TURNIP or SPAWN_ALIEN_TORPEDO
+	int fireSound;				// goes with the weapon; set by AlienArchetypes
+	int fireNumerator;			// with the player in its line of fire, shoots with odds 1 in (fireNumerator / level + fireBase)
+	int fireBase;
+	double ramSpeed;			// if not 0, the roll after the one that shoots switches it to ramming at this speed
+	int dropOdds;				// when killed, drops a goodie with odds 1 in dropOdds (0 for never)
+	int numDrops;				// the goodie is one of drops[0 .. numDrops - 1], chosen evenly
+	int drops[MAX_ALIEN_DROPS];	// SPAWN_*_GOODIE
+	int weight;					// decideShipToAdd's weight for it: weight + weightPerLevel * level
+	int weightPerLevel;
+};
+
+// An archetype's numbers for the level in progress, worked out once per level by StudentWorld so that aliens
+// neither ask for the level nor divide by it while they play
+struct AlienLevelStats
+{
+	double hitPoints;			// a new alien's hit points
+	int fireRange;				// possiblyShoot rolls randInt(1, fireRange): 1 shoots, 2 may start ramming
+	int spawnWeightUpTo;		// decideShipToAdd's weights of this archetype and all those before it
+};
+
+// The table of alien archetypes. Starts out as the three original aliens (Smallgon, Smoregon, Snagglegon);
+// load replaces it from a text file with one archetype per line, in the format of aliens.txt.
+class AlienArchetypes
+{
+public:
+	// Constructor
+	AlienArchetypes();
+
+	// Accessors
+	int size() const;
+	const AlienArchetype& get(int i) const;
+	uint32_t hash() const;				// of every row, so recordings and snapshots can tell which table they were made with
+
+	// Mutators
+	bool load(const string& path);		// false (table unchanged) if the file is missing or has a bad line
+
+private:
+	void add(const AlienArchetype& a);
+
+	vector<AlienArchetype> m_archetypes;
+};
+
+#endif // ALIENARCHETYPES_H_
@@ -0,0 +1,128 @@
+#include "CollisionKernel.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+bool circlesCollide(double ax, double ay, double ar, double bx, double by, double br)
+{
+	double dx = bx - ax;
+	double dy = by - ay;
+	double limit = .75 * (ar + br);
+	return dx * dx + dy * dy < limit * limit;
+}
+
+// the scalar test in the coordinate type itself, so float and fixed point agree with their vector loops
+#if defined(COORD_FIXED)
+static bool coordsCollide(Coord ax, Coord ay, Coord ar, Coord bx, Coord by, Coord br)
+{
+	int64_t dx = bx.raw() - ax.raw();
+	int64_t dy = by.raw() - ay.raw();
+	int64_t limit = 3 * (int64_t(ar.raw()) + br.raw()) / 4;		// exact: radii are whole numbers
+	return dx * dx + dy * dy < limit * limit;
+}
+#elif defined(COORD_FLOAT)
+static bool coordsCollide(float ax, float ay, float ar, float bx, float by, float br)
+{
+	float dx = bx - ax;
+	float dy = by - ay;
+	float limit = .75f * (ar + br);
+	return dx * dx + dy * dy < limit * limit;
+}
+#else
+static bool coordsCollide(double ax, double ay, double ar, double bx, double by, double br)
+{
+	return circlesCollide(ax, ay, ar, bx, by, br);
+}
+#endif
+
+int findCollisions(Coord x, Coord y, Coord r, const Coord* xs, const Coord* ys, const Coord* rs, int n, int* hits)
+{
+	int numHits = 0;
+	int i = 0;
+
+#if defined(COORD_FIXED)
+	// no vector loop: 64-bit integer multiplies only vectorize well with AVX-512
+#elif defined(COORD_FLOAT) && defined(__AVX__)
+	const __m256 vx = _mm256_set1_ps(x);
+	const __m256 vy = _mm256_set1_ps(y);
+	const __m256 vr = _mm256_set1_ps(r);
+	const __m256 scale = _mm256_set1_ps(.75f);
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vx);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vy);
+		__m256 limit = _mm256_mul_ps(scale, _mm256_add_ps(vr, _mm256_loadu_ps(rs + i)));
+		__m256 dist2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		int mask = _mm256_movemask_ps(_mm256_cmp_ps(dist2, _mm256_mul_ps(limit, limit), _CMP_LT_OQ));
+		for (int lane = 0; mask != 0; lane++, mask >>= 1)
+		{
+			if (mask & 1)
+				hits[numHits++] = i + lane;
+		}
+	}
+#elif defined(COORD_FLOAT) && defined(__SSE2__)
+	const __m128 vx = _mm_set1_ps(x);
+	const __m128 vy = _mm_set1_ps(y);
+	const __m128 vr = _mm_set1_ps(r);
+	const __m128 scale = _mm_set1_ps(.75f);
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), vx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), vy);
+		__m128 limit = _mm_mul_ps(scale, _mm_add_ps(vr, _mm_loadu_ps(rs + i)));
+		__m128 dist2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		int mask = _mm_movemask_ps(_mm_cmplt_ps(dist2, _mm_mul_ps(limit, limit)));
+		for (int lane = 0; mask != 0; lane++, mask >>= 1)
+		{
+			if (mask & 1)
+				hits[numHits++] = i + lane;
+		}
+	}
+#elif defined(__AVX__)
+	const __m256d vx = _mm256_set1_pd(x);
+	const __m256d vy = _mm256_set1_pd(y);
+	const __m256d vr = _mm256_set1_pd(r);
+	const __m256d scale = _mm256_set1_pd(.75);
+	for (; i + 4 <= n; i += 4)
+	{
+		__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), vx);
+		__m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), vy);
+		__m256d limit = _mm256_mul_pd(scale, _mm256_add_pd(vr, _mm256_loadu_pd(rs + i)));
+		__m256d dist2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+		int mask = _mm256_movemask_pd(_mm256_cmp_pd(dist2, _mm256_mul_pd(limit, limit), _CMP_LT_OQ));
+		for (int lane = 0; mask != 0; lane++, mask >>= 1)
+		{
+			if (mask & 1)
+				hits[numHits++] = i + lane;
+		}
+	}
+#elif defined(__SSE2__)
+	const __m128d vx = _mm_set1_pd(x);
+	const __m128d vy = _mm_set1_pd(y);
+	const __m128d vr = _mm_set1_pd(r);
+	const __m128d scale = _mm_set1_pd(.75);
+	for (; i + 2 <= n; i += 2)
+	{
+		__m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + i), vx);
+		__m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + i), vy);
+		__m128d limit = _mm_mul_pd(scale, _mm_add_pd(vr, _mm_loadu_pd(rs + i)));
+		__m128d dist2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+		int mask = _mm_movemask_pd(_mm_cmplt_pd(dist2, _mm_mul_pd(limit, limit)));
+		if (mask & 1)
+			hits[numHits++] = i;
+		if (mask & 2)
+			hits[numHits++] = i + 1;
+	}
+#endif
+
+	// scalar fallback, and the tail the vector loop did not cover
+	for (; i < n; i++)
+	{
+		if (coordsCollide(x, y, r, xs[i], ys[i], rs[i]))
+			hits[numHits++] = i;
+	}
+	return numHits;
+}
@@ -0,0 +1,20 @@
+#ifndef COLLISIONKERNEL_H_
+#define COLLISIONKERNEL_H_
+
+#include "Coord.h"
+
+// Narrow phase of collision detection. Two circles collide when dist < .75 * (rA + rB); the kernels
+// compare dx*dx + dy*dy against (.75 * (rA + rB))^2 instead, which avoids the sqrt and gives the same
+// answer for every position the game produces (all moves are multiples of .25 and radii are whole
+// numbers, so both sides are exact and never land within rounding distance of each other).
+
+// Is the circle (ax, ay, ar) touching the circle (bx, by, br)?
+bool circlesCollide(double ax, double ay, double ar, double bx, double by, double br);
+
+// Tests the circle (x, y, r) against n candidates packed in xs/ys/rs. Writes the indices of the
+// candidates it collides with to hits, in increasing order, and returns how many there were.
+// Uses AVX or SSE2 when the compiler targets them (4 or 2 lanes of double, 8 or 4 of float), and plain
+// scalar code otherwise; fixed point is always scalar, squaring in 64-bit integers.
+int findCollisions(Coord x, Coord y, Coord r, const Coord* xs, const Coord* ys, const Coord* rs, int n, int* hits);
+
+#endif // COLLISIONKERNEL_H_
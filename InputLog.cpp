@@ -0,0 +1,227 @@
+#include "InputLog.h"
+#include "GameConstants.h"
+#include <cstdio>
+using namespace std;
+
+const unsigned int INPUT_LOG_MAGIC = 0x3149424e;		// "NBI1"
+const unsigned int INPUT_LOG_VERSION = 5;		// 4 had no alien table hash, 3 no parallel update flag; older ones hashed stars as actors
+
+// keys the game actually uses get a one-byte code; anything else is KEY_ESCAPED followed by the raw value
+static const int KEY_CODES[] = { KEY_PRESS_LEFT, KEY_PRESS_RIGHT, KEY_PRESS_UP, KEY_PRESS_DOWN, KEY_PRESS_SPACE, KEY_PRESS_TAB, KEY_PRESS_ESCAPE };
+const int NUM_KEY_CODES = sizeof(KEY_CODES) / sizeof(KEY_CODES[0]);
+const unsigned char KEY_ESCAPED = 0xff;
+
+InputLog::Setup::Setup()
+	: seed(0), level(0), lives(0), collisionMode(COLLIDE_PER_ACTOR), spawnTiming(SPAWN_ACTS_SAME_TICK), parallelUpdate(false), archetypesHash(0)
+{
+}
+
+InputLog::InputLog()
+{
+}
+
+const InputLog::Setup& InputLog::setup() const
+{
+	return m_setup;
+}
+
+size_t InputLog::numTicks() const
+{
+	return m_hashes.size();
+}
+
+size_t InputLog::numKeys() const
+{
+	return m_keys.size();
+}
+
+int InputLog::key(size_t i) const
+{
+	return m_keys[i];
+}
+
+uint32_t InputLog::tickHash(size_t tick) const
+{
+	return m_hashes[tick];
+}
+
+void InputLog::start(const Setup& setup)
+{
+	m_setup = setup;
+	m_keys.clear();
+	m_keysPerTick.clear();
+	m_hashes.clear();
+	m_keysPerTick.push_back(0);
+}
+
+void InputLog::addKey(int key)
+{
+	m_keys.push_back(key);
+	m_keysPerTick.back()++;
+}
+
+void InputLog::endTick(uint32_t hash)
+{
+	m_hashes.push_back(hash);
+	m_keysPerTick.push_back(0);
+}
+
+// little-endian, whatever the host, so logs move between machines
+static void put32(vector<unsigned char>& out, uint32_t v)
+{
+	for (int i = 0; i < 4; i++)
+		out.push_back(static_cast<unsigned char>(v >> (8 * i)));
+}
+
+static void put64(vector<unsigned char>& out, uint64_t v)
+{
+	put32(out, static_cast<uint32_t>(v));
+	put32(out, static_cast<uint32_t>(v >> 32));
+}
+
+static bool get32(const vector<unsigned char>& in, size_t& pos, uint32_t& v)
+{
+	if (pos + 4 > in.size())
+		return false;
+	v = 0;
+	for (int i = 0; i < 4; i++)
+		v |= static_cast<uint32_t>(in[pos++]) << (8 * i);
+	return true;
+}
+
+static bool get64(const vector<unsigned char>& in, size_t& pos, uint64_t& v)
+{
+	uint32_t low, high;
+	if (!get32(in, pos, low) || !get32(in, pos, high))
+		return false;
+	v = (static_cast<uint64_t>(high) << 32) | low;
+	return true;
+}
+
+bool InputLog::save(const string& path) const
+{
+	vector<unsigned char> out;
+	put32(out, INPUT_LOG_MAGIC);
+	put32(out, INPUT_LOG_VERSION);
+	put64(out, m_setup.seed);
+	put32(out, m_setup.level);
+	put32(out, m_setup.lives);
+	put32(out, m_setup.collisionMode);
+	put32(out, m_setup.spawnTiming);
+	put32(out, m_setup.parallelUpdate);
+	put32(out, m_setup.archetypesHash);
+	put32(out, m_setup.tuning.initialStars);
+	put32(out, m_setup.tuning.maxAliensOnScreen);
+	put32(out, m_setup.tuning.alienShipsToBeDestroyed);
+	put32(out, m_setup.tuning.smallgonWeight);
+	put32(out, m_setup.tuning.smoregonWeight);
+	put32(out, m_setup.tuning.snagglegonWeight);
+	put64(out, m_hashes.size());
+
+	size_t next = 0;
+	for (size_t t = 0; t < m_hashes.size(); t++)
+	{
+		out.push_back(m_keysPerTick[t]);
+		for (int k = 0; k < m_keysPerTick[t]; k++, next++)
+		{
+			int key = m_keys[next];
+			int code = 0;
+			while (code < NUM_KEY_CODES && KEY_CODES[code] != key)
+				code++;
+			if (key == NO_KEY)
+				out.push_back(0);
+			else if (code < NUM_KEY_CODES)
+				out.push_back(code + 1);
+			else
+			{
+				out.push_back(KEY_ESCAPED);
+				put32(out, key);
+			}
+		}
+		put32(out, m_hashes[t]);
+	}
+
+	FILE* f = fopen(path.c_str(), "wb");
+	if (f == nullptr)
+		return false;
+	bool written = fwrite(&out[0], 1, out.size(), f) == out.size();
+	return fclose(f) == 0 && written;
+}
+
+bool InputLog::load(const string& path)
+{
+	FILE* f = fopen(path.c_str(), "rb");
+	if (f == nullptr)
+		return false;
+	vector<unsigned char> in;
+	unsigned char buffer[4096];
+	size_t n;
+	while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0)
+		in.insert(in.end(), buffer, buffer + n);
+	fclose(f);
+
+	// parse into a fresh log, so a bad file leaves this one alone
+	InputLog log;
+	size_t pos = 0;
+	uint32_t magic, version, level, lives, mode, spawnTiming, parallelUpdate, archetypesHash, tuning[6];
+	uint64_t seed, numTicks;
+	if (!get32(in, pos, magic) || !get32(in, pos, version) || magic != INPUT_LOG_MAGIC || version != INPUT_LOG_VERSION)
+		return false;
+	if (!get64(in, pos, seed) || !get32(in, pos, level) || !get32(in, pos, lives) || !get32(in, pos, mode) || !get32(in, pos, spawnTiming)
+		|| !get32(in, pos, parallelUpdate) || !get32(in, pos, archetypesHash))
+		return false;
+	for (int i = 0; i < 6; i++)
+	{
+		if (!get32(in, pos, tuning[i]))
+			return false;
+	}
+	if (!get64(in, pos, numTicks))
+		return false;
+
+	Setup setup;
+	setup.seed = seed;
+	setup.level = level;
+	setup.lives = lives;
+	setup.collisionMode = mode;
+	setup.spawnTiming = spawnTiming;
+	setup.parallelUpdate = parallelUpdate != 0;
+	setup.archetypesHash = archetypesHash;
+	setup.tuning.initialStars = tuning[0];
+	setup.tuning.maxAliensOnScreen = tuning[1];
+	setup.tuning.alienShipsToBeDestroyed = tuning[2];
+	setup.tuning.smallgonWeight = tuning[3];
+	setup.tuning.smoregonWeight = tuning[4];
+	setup.tuning.snagglegonWeight = tuning[5];
+	log.start(setup);
+
+	for (uint64_t t = 0; t < numTicks; t++)
+	{
+		if (pos >= in.size())
+			return false;
+		int keys = in[pos++];
+		for (int k = 0; k < keys; k++)
+		{
+			if (pos >= in.size())
+				return false;
+			unsigned char code = in[pos++];
+			uint32_t raw;
+			if (code == 0)
+				log.addKey(NO_KEY);
+			else if (code <= NUM_KEY_CODES)
+				log.addKey(KEY_CODES[code - 1]);
+			else if (code == KEY_ESCAPED && get32(in, pos, raw))
+				log.addKey(static_cast<int>(raw));
+			else
+				return false;
+		}
+		uint32_t hash;
+		if (!get32(in, pos, hash))
+			return false;
+		log.endTick(hash);
+	}
+	if (pos != in.size())
+		return false;
+
+	*this = log;
+	return true;
+}
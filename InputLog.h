@@ -0,0 +1,56 @@
+#ifndef INPUTLOG_H_
+#define INPUTLOG_H_
+
+#include "StudentWorld.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+const int NO_KEY = -1;		// a getKey call that returned false
+
+// Everything a StudentWorld read from the keyboard, tick by tick, plus what is needed to start an identical
+// world: replaying the keys into a world made from setup() must reproduce the run exactly, which each
+// tick's state hash checks. Written to disk in a compact byte format (about 6 bytes per tick).
+class InputLog
+{
+public:
+	// How the recorded world was set up before its first init()
+	struct Setup
+	{
+		Setup();
+		uint64_t seed;
+		unsigned int level;
+		unsigned int lives;
+		int collisionMode;
+		int spawnTiming;
+		bool parallelUpdate;		// setUpdateThreads(n >= 1); the thread count does not change the game
+		uint32_t archetypesHash;	// StudentWorld::alienArchetypesHash; replaying needs the same NACHENBLASTER_ALIENS table
+		WorldTuning tuning;
+	};
+
+	// Constructor
+	InputLog();
+
+	// Accessors
+	const Setup& setup() const;
+	size_t numTicks() const;
+	size_t numKeys() const;
+	int key(size_t i) const;					// i-th getKey result over the whole run, NO_KEY if none
+	uint32_t tickHash(size_t tick) const;		// state hash at the end of the tick
+	bool save(const string& path) const;
+
+	// Mutators
+	void start(const Setup& setup);				// forgets any previous recording
+	void addKey(int key);
+	void endTick(uint32_t hash);
+	bool load(const string& path);				// false (log unchanged) if the file is missing or not a log
+
+private:
+	Setup m_setup;
+	vector<int> m_keys;
+	vector<unsigned char> m_keysPerTick;
+	vector<uint32_t> m_hashes;
+};
+
+#endif // INPUTLOG_H_
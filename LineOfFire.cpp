@@ -0,0 +1,63 @@
+#include "LineOfFire.h"
+#include <algorithm>
+using namespace std;
+
+LineOfFire::LineOfFire()
+{
+	clear();
+}
+
+bool LineOfFire::covers(double x, double y) const
+{
+	return m_playerX < x && y >= m_minY && y <= m_maxY;
+}
+
+void LineOfFire::refresh(double playerX, double playerY)
+{
+	m_playerX = playerX;
+	m_minY = playerY - LINE_OF_FIRE_BAND;
+	m_maxY = playerY + LINE_OF_FIRE_BAND;
+	m_sorted = false;
+}
+
+int LineOfFire::shooters(const ActorColumns& aliens, vector<Actor*>& out)
+{
+	if (!m_sorted)
+	{
+		m_byY.clear();
+		for (size_t i = 0; i < aliens.y.size(); i++)
+		{
+			if (!aliens.alive[i])
+				continue;
+			Entry e = { toDouble(aliens.y[i]), toDouble(aliens.x[i]), aliens.actor[i] };
+			m_byY.push_back(e);
+		}
+		sort(m_byY.begin(), m_byY.end(), lowerY);
+		m_sorted = true;
+	}
+
+	out.clear();
+	Entry first = { m_minY, 0, nullptr };
+	for (vector<Entry>::const_iterator e = lower_bound(m_byY.begin(), m_byY.end(), first, lowerY);
+		e != m_byY.end() && e->y <= m_maxY; ++e)
+	{
+		if (m_playerX < e->x)
+			out.push_back(e->actor);
+	}
+	return out.size();
+}
+
+// an empty band until the first refresh
+void LineOfFire::clear()
+{
+	m_playerX = 0;
+	m_minY = 1;
+	m_maxY = 0;
+	m_byY.clear();
+	m_sorted = false;
+}
+
+bool LineOfFire::lowerY(const Entry& a, const Entry& b)
+{
+	return a.y < b.y;
+}
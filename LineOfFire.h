@@ -0,0 +1,47 @@
+#ifndef LINEOFFIRE_H_
+#define LINEOFFIRE_H_
+
+#include "ActorStore.h"
+#include <vector>
+using namespace std;
+
+class Actor;
+
+const double LINE_OF_FIRE_BAND = 4;		// an alien can shoot at the NachenBlaster if their y's are this close and it is to the alien's left
+
+// Which aliens have the NachenBlaster in their line of fire. The NachenBlaster only moves in its own
+// doSomething, so the world refreshes this once per tick right after that; from then on an alien's test is
+// three comparisons against the cached band, and "every alien that could shoot" is one range query over
+// the aliens sorted by y. Most ticks nobody asks for the whole list, so the sorted index is only built by
+// the first such query after a refresh, from the aliens as they stand then.
+class LineOfFire
+{
+public:
+	// Constructor
+	LineOfFire();
+
+	// Accessors
+	bool covers(double x, double y) const;				// could an alien at (x, y) shoot at the NachenBlaster?
+
+	// Mutators
+	void refresh(double playerX, double playerY);
+	int shooters(const ActorColumns& aliens, vector<Actor*>& out);	// replaces out with the live aliens that could, in order of y; returns how many
+	void clear();
+
+private:
+	struct Entry
+	{
+		double y;
+		double x;
+		Actor* actor;
+	};
+	static bool lowerY(const Entry& a, const Entry& b);
+
+	double m_playerX;
+	double m_minY;			// the band of alien y's that have the NachenBlaster in range
+	double m_maxY;
+	vector<Entry> m_byY;	// live aliens at the first query since the last refresh, sorted by y; reused every tick
+	bool m_sorted;			// whether m_byY has been built since the last refresh
+};
+
+#endif // LINEOFFIRE_H_
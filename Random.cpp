@@ -0,0 +1,62 @@
+#include "Random.h"
+#include <algorithm>
+using namespace std;
+
+Rng::Rng(uint64_t seed)
+{
+	this->seed(seed);
+}
+
+uint64_t Rng::state() const
+{
+	return m_state;
+}
+
+uint64_t Rng::stream() const
+{
+	return m_increment >> 1;
+}
+
+void Rng::seed(uint64_t seed, uint64_t stream)
+{
+	m_state = 0;
+	m_increment = (stream << 1) | 1;
+	next();
+	m_state += seed;
+	next();
+}
+
+void Rng::restore(uint64_t state, uint64_t stream)
+{
+	m_state = state;
+	m_increment = (stream << 1) | 1;
+}
+
+int Rng::randInt(int min, int max)
+{
+	if (max < min)
+		swap(max, min);
+
+	// Lemire's multiply-and-reject: unbiased, and almost never needs more than one draw
+	uint32_t range = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1;
+	if (range == 0)		// [INT_MIN, INT_MAX]
+		return static_cast<int>(next());
+	uint64_t m = static_cast<uint64_t>(next()) * range;
+	uint32_t low = static_cast<uint32_t>(m);
+	if (low < range)
+	{
+		uint32_t threshold = (0u - range) % range;
+		while (low < threshold)
+		{
+			m = static_cast<uint64_t>(next()) * range;
+			low = static_cast<uint32_t>(m);
+		}
+	}
+	return min + static_cast<int>(m >> 32);
+}
+
+void Rng::fill(uint32_t* out, int n)
+{
+	for (int i = 0; i < n; i++)
+		out[i] = next();
+}
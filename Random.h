@@ -0,0 +1,40 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <cstdint>
+
+// Small, fast, seedable random number generator (PCG32: 64 bits of state, 32-bit output).
+// Every StudentWorld owns one, so a world's run is reproducible bit for bit from its seed and
+// independent of any other world, unlike the framework's global randInt.
+class Rng
+{
+public:
+	// Constructor
+	Rng(uint64_t seed = 1);
+
+	// Accessors
+	uint64_t state() const;
+	uint64_t stream() const;
+
+	// Mutators
+	void seed(uint64_t seed, uint64_t stream = 0);		// different streams give independent sequences for the same seed
+	void restore(uint64_t state, uint64_t stream);		// resumes exactly where state()/stream() were read
+	uint32_t next();									// 32 random bits
+	int randInt(int min, int max);						// uniform in [min, max], drop-in for the framework's randInt
+	void fill(uint32_t* out, int n);					// n random words at once, for code that wants a tick's worth up front
+
+private:
+	uint64_t m_state;
+	uint64_t m_increment;		// always odd; selects the stream
+};
+
+inline uint32_t Rng::next()
+{
+	uint64_t old = m_state;
+	m_state = old * 6364136223846793005ULL + m_increment;
+	uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+	uint32_t rotation = static_cast<uint32_t>(old >> 59);
+	return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+#endif // RANDOM_H_
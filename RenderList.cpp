@@ -0,0 +1,66 @@
+#include "RenderList.h"
+using namespace std;
+
+RenderList::RenderList()
+	: m_front(0), m_maxDepth(0), m_maxImageID(0), m_frame(0)
+{
+	m_buffers[0].reserve(RENDER_LIST_RESERVE);
+	m_buffers[1].reserve(RENDER_LIST_RESERVE);
+	m_sorted.reserve(RENDER_LIST_RESERVE);
+	m_starts.reserve(RENDER_BUCKET_RESERVE);
+}
+
+unsigned long RenderList::frame() const
+{
+	return m_frame;
+}
+
+const vector<RenderItem>& RenderList::acquire()
+{
+	m_frontMutex.lock();
+	return m_buffers[m_front];
+}
+
+void RenderList::release()
+{
+	m_frontMutex.unlock();
+}
+
+void RenderList::begin()
+{
+	m_buffers[1 - m_front].clear();		// clear() keeps capacity, so a steady screen never allocates
+	m_maxDepth = 0;
+	m_maxImageID = 0;
+}
+
+void RenderList::add(int imageID, int depth, double x, double y, double size, int direction)
+{
+	RenderItem item = { imageID, depth, x, y, size, direction };
+	m_buffers[1 - m_front].push_back(item);
+	if (depth > m_maxDepth)
+		m_maxDepth = depth;
+	if (imageID > m_maxImageID)
+		m_maxImageID = imageID;
+}
+
+void RenderList::publish()
+{
+	// a stable counting sort on (deepest first, then image ID): there are only a few dozen buckets, and
+	// sprites of one kind keep the order they were added in, so equal sprites never swap places between frames
+	vector<RenderItem>& back = m_buffers[1 - m_front];
+	int imageIDs = m_maxImageID + 1;
+	m_starts.assign((m_maxDepth + 1) * imageIDs + 1, 0);
+	for (size_t i = 0; i < back.size(); i++)
+		m_starts[(m_maxDepth - back[i].depth) * imageIDs + back[i].imageID + 1]++;
+	for (size_t b = 1; b < m_starts.size(); b++)
+		m_starts[b] += m_starts[b - 1];
+	m_sorted.resize(back.size());
+	for (size_t i = 0; i < back.size(); i++)
+		m_sorted[m_starts[(m_maxDepth - back[i].depth) * imageIDs + back[i].imageID]++] = back[i];
+	back.swap(m_sorted);
+
+	m_frontMutex.lock();
+	m_front = 1 - m_front;
+	m_frame++;
+	m_frontMutex.unlock();
+}
@@ -0,0 +1,58 @@
+#ifndef RENDERLIST_H_
+#define RENDERLIST_H_
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+// One sprite to draw
+struct RenderItem
+{
+	int imageID;
+	int depth;
+	double x;
+	double y;
+	double size;
+	int direction;
+};
+
+// Everything on screen after a tick, as a flat array sorted back to front by depth and then by image ID,
+// so a backend can issue one instanced draw per run of the same sprite. The world builds the next list
+// in a back buffer while the last one it published stays readable: a renderer can draw tick N from another
+// thread while tick N + 1 is simulated, holding the front buffer between acquire and release.
+const int RENDER_LIST_RESERVE = 256;		// sprites a list has room for before its buffers have to grow
+const int RENDER_BUCKET_RESERVE = 256;		// (depth, image ID) buckets the sort has room for
+
+class RenderList
+{
+public:
+	// Constructor
+	RenderList();
+
+	// Accessors
+	unsigned long frame() const;			// how many lists have been published; safe to ask from any thread
+
+	// Mutators
+	const vector<RenderItem>& acquire();	// the last published list; it stays put until release
+	void release();
+	void begin();							// starts a new list in the back buffer
+	void add(int imageID, int depth, double x, double y, double size, int direction);		// imageID and depth are never negative
+	void publish();							// sorts the back buffer and swaps it to the front
+
+private:
+	// no copying: the mutex guards one pair of buffers
+	RenderList(const RenderList&);
+	RenderList& operator=(const RenderList&);
+
+	vector<RenderItem> m_buffers[2];
+	int m_front;					// index of the published buffer in m_buffers
+	vector<RenderItem> m_sorted;	// scratch for the counting sort; swapped with the back buffer
+	vector<int> m_starts;			// scratch: first output index of each (depth, image ID) bucket
+	int m_maxDepth;					// largest depth and image ID added since begin, which size the buckets
+	int m_maxImageID;
+	atomic<unsigned long> m_frame;
+	mutex m_frontMutex;				// held by a reader between acquire and release, and by publish to swap
+};
+
+#endif // RENDERLIST_H_
@@ -0,0 +1,55 @@
+#include "SoundQueue.h"
+using namespace std;
+
+SoundQueue::SoundQueue()
+	: m_voices(SOUND_QUEUE_RESERVE, 0), m_voicesPerSound(SOUND_VOICES_PER_ID), m_coalesced(0)
+{
+	m_sounds.reserve(SOUND_QUEUE_RESERVE);
+}
+
+int SoundQueue::size() const
+{
+	return m_sounds.size();
+}
+
+int SoundQueue::soundAt(int i) const
+{
+	return m_sounds[i];
+}
+
+unsigned long SoundQueue::coalesced() const
+{
+	return m_coalesced;
+}
+
+void SoundQueue::setVoicesPerSound(int voices)
+{
+	m_voicesPerSound = voices;
+}
+
+void SoundQueue::add(int soundID)
+{
+	if (m_voicesPerSound > 0 && soundID >= 0)
+	{
+		if (soundID >= static_cast<int>(m_voices.size()))
+			m_voices.resize(soundID + 1, 0);
+		if (m_voices[soundID] >= m_voicesPerSound)
+		{
+			m_coalesced++;
+			return;
+		}
+		m_voices[soundID]++;
+	}
+	m_sounds.push_back(soundID);
+}
+
+void SoundQueue::clear()
+{
+	// only the queued IDs have counts to reset, so this costs the tick's sounds, not the number of IDs
+	for (size_t i = 0; i < m_sounds.size(); i++)
+	{
+		if (m_sounds[i] >= 0 && m_sounds[i] < static_cast<int>(m_voices.size()))
+			m_voices[m_sounds[i]] = 0;
+	}
+	m_sounds.clear();
+}
@@ -0,0 +1,36 @@
+#ifndef SOUNDQUEUE_H_
+#define SOUNDQUEUE_H_
+
+#include <vector>
+using namespace std;
+
+const int SOUND_VOICES_PER_ID = 2;		// default cap on how many times one sound plays in a tick
+const int SOUND_QUEUE_RESERVE = 32;		// sounds a tick can queue, and sound IDs it can count, before the queue has to grow
+
+// The sounds asked for during a tick, in the order they were first asked for. A wave dying at once can ask
+// for dozens of SOUND_DEATHs in one tick; past the cap for its ID a request is coalesced into the ones
+// already queued rather than queued again. The world plays the queue once, at the end of move().
+class SoundQueue
+{
+public:
+	// Constructor
+	SoundQueue();
+
+	// Accessors
+	int size() const;
+	int soundAt(int i) const;
+	unsigned long coalesced() const;		// requests dropped by the cap since the queue was made
+
+	// Mutators
+	void setVoicesPerSound(int voices);		// 0 for no cap: every request plays
+	void add(int soundID);
+	void clear();							// after the queue has been played (or thrown away)
+
+private:
+	vector<int> m_sounds;
+	vector<int> m_voices;			// sound ID -> times queued this tick; only the IDs in m_sounds are ever nonzero
+	int m_voicesPerSound;
+	unsigned long m_coalesced;
+};
+
+#endif // SOUNDQUEUE_H_
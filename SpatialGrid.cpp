@@ -0,0 +1,104 @@
+#include "SpatialGrid.h"
+#include "GameConstants.h"
+#include <algorithm>
+using namespace std;
+
+SpatialGrid::SpatialGrid()
+	: m_columns((VIEW_WIDTH + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE), m_rows((VIEW_HEIGHT + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE),
+	m_cells(m_columns * m_rows), m_maxRadius(0)
+{
+	// actors wander into cells that have never held one; without room set aside up front, a cell's first
+	// few arrivals would each allocate in the middle of a tick
+	for (vector<vector<ActorHandle> >::iterator c = m_cells.begin(); c != m_cells.end(); c++)
+		c->reserve(GRID_CELL_RESERVE);
+}
+
+int SpatialGrid::columnOf(double x) const
+{
+	// actors can be created just off screen (e.g. a cabbage fired at the right edge), so clamp into the grid
+	int col = static_cast<int>(x) / GRID_CELL_SIZE;
+	if (x < 0)
+		col = 0;
+	return min(col, m_columns - 1);
+}
+
+int SpatialGrid::rowOf(double y) const
+{
+	int row = static_cast<int>(y) / GRID_CELL_SIZE;
+	if (y < 0)
+		row = 0;
+	return min(row, m_rows - 1);
+}
+
+int SpatialGrid::cellOf(double x, double y) const
+{
+	return rowOf(y) * m_columns + columnOf(x);
+}
+
+int SpatialGrid::insert(ActorHandle h, double x, double y, double radius)
+{
+	int cell = cellOf(x, y);
+	m_cells[cell].push_back(h);
+	m_maxRadius = max(m_maxRadius, radius);
+	return cell;
+}
+
+void SpatialGrid::remove(ActorHandle h, int cell)
+{
+	if (cell < 0)
+		return;
+
+	// order inside a cell does not matter, so swap with the back and pop
+	vector<ActorHandle>& c = m_cells[cell];
+	for (vector<ActorHandle>::iterator p = c.begin(); p != c.end(); p++)
+	{
+		if (p->category == h.category && p->slot == h.slot)
+		{
+			*p = c.back();
+			c.pop_back();
+			return;
+		}
+	}
+}
+
+int SpatialGrid::update(ActorHandle h, int cell, double x, double y)
+{
+	if (cell < 0)
+		return cell;
+
+	int newCell = cellOf(x, y);
+	if (newCell != cell)
+	{
+		remove(h, cell);
+		m_cells[newCell].push_back(h);
+	}
+	return newCell;
+}
+
+void SpatialGrid::clear()
+{
+	// clear() keeps capacity, so the next level does not reallocate
+	for (vector<vector<ActorHandle> >::iterator c = m_cells.begin(); c != m_cells.end(); c++)
+		c->clear();
+	m_maxRadius = 0;
+}
+
+void SpatialGrid::query(double x, double y, double radius, vector<ActorHandle>& out) const
+{
+	// any actor b colliding with the circle satisfies dist < .75 * (radius + rB) <= reach,
+	// so its center (and therefore its cell) lies inside the square of half-width reach
+	double reach = .75 * (radius + m_maxRadius);
+	int firstCol = columnOf(x - reach);
+	int lastCol = columnOf(x + reach);
+	int firstRow = rowOf(y - reach);
+	int lastRow = rowOf(y + reach);
+
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		for (int col = firstCol; col <= lastCol; col++)
+		{
+			const vector<ActorHandle>& cell = m_cells[row * m_columns + col];
+			out.insert(out.end(), cell.begin(), cell.end());
+		}
+	}
+}
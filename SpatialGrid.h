@@ -0,0 +1,41 @@
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#include "ActorStore.h"
+#include <vector>
+using namespace std;
+
+const int GRID_CELL_SIZE = 16;		// width/height (in pixels) of one grid cell
+const int GRID_CELL_RESERVE = 8;	// actors each cell has room for before it has to grow
+
+// Uniform grid over the VIEW_WIDTH x VIEW_HEIGHT playfield, used as the broad phase of collision checks.
+// Each registered actor lives in exactly one cell (the one containing its center), so a collision query
+// only needs to visit the cells within .75 * (rA + largest registered radius) of the querying actor.
+// The grid does not remember where an actor is; callers keep the cell returned by insert/update.
+class SpatialGrid
+{
+public:
+	// Constructor
+	SpatialGrid();
+
+	// Accessors
+	int cellOf(double x, double y) const;
+	void query(double x, double y, double radius, vector<ActorHandle>& out) const;	// appends every actor in a cell that could hold an actor colliding with a circle of radius at (x, y)
+
+	// Mutators
+	int insert(ActorHandle h, double x, double y, double radius);		// registers h at (x, y), returns its cell
+	void remove(ActorHandle h, int cell);								// unregisters h from cell
+	int update(ActorHandle h, int cell, double x, double y);			// moves h out of cell if (x, y) is in another one, returns its cell
+	void clear();														// unregisters everything
+
+private:
+	int columnOf(double x) const;
+	int rowOf(double y) const;
+
+	int m_columns;
+	int m_rows;
+	vector<vector<ActorHandle> > m_cells;
+	double m_maxRadius;				// largest radius ever registered, bounds the query reach
+};
+
+#endif // SPATIALGRID_H_
@@ -0,0 +1,93 @@
+#include "Starfield.h"
+#include "GraphObject.h"
+#include "GameConstants.h"
+#include <new>
+using namespace std;
+
+Starfield::Starfield()
+	: m_spritePool(sizeof(GraphObject))
+{
+	m_x.reserve(STARFIELD_RESERVE);
+	m_y.reserve(STARFIELD_RESERVE);
+	m_size.reserve(STARFIELD_RESERVE);
+	m_sprites.reserve(STARFIELD_RESERVE);
+}
+
+Starfield::~Starfield()
+{
+	clear();		// before m_spritePool goes
+}
+
+int Starfield::size() const
+{
+	return m_x.size();
+}
+
+double Starfield::x(int i) const
+{
+	return toDouble(m_x[i]);
+}
+
+double Starfield::y(int i) const
+{
+	return toDouble(m_y[i]);
+}
+
+double Starfield::starSize(int i) const
+{
+	return m_size[i];
+}
+
+void Starfield::add(double x, double y, double size)
+{
+	m_x.push_back(toCoord(x));
+	m_y.push_back(toCoord(y));
+	m_size.push_back(size);
+	m_sprites.push_back(new (m_spritePool.allocate(sizeof(GraphObject))) GraphObject(IID_STAR, x, y, 0, size, STAR_DEPTH));
+}
+
+void Starfield::removeSprite(int i)
+{
+	m_sprites[i]->~GraphObject();
+	ActorPool::release(m_sprites[i]);
+}
+
+void Starfield::update()
+{
+	const Coord step = toCoord(1);
+	const Coord left = toCoord(0);
+	int n = m_x.size();
+	for (int i = 0; i < n; i++)
+		m_x[i] -= step;
+
+	// a star that has left the screen swaps with the last one; their order does not matter
+	for (int i = n - 1; i >= 0; i--)
+	{
+		if (m_x[i] >= left)
+			continue;
+		removeSprite(i);
+		n--;
+		m_x[i] = m_x[n];
+		m_y[i] = m_y[n];
+		m_size[i] = m_size[n];
+		m_sprites[i] = m_sprites[n];
+	}
+	m_x.resize(n);
+	m_y.resize(n);
+	m_size.resize(n);
+	m_sprites.resize(n);
+
+	for (int i = 0; i < n; i++)
+		m_sprites[i]->moveTo(toDouble(m_x[i]), toDouble(m_y[i]));
+}
+
+void Starfield::clear()
+{
+	for (int i = 0; i < size(); i++)
+		removeSprite(i);
+	// clear() keeps capacity, so the next level does not reallocate
+	m_x.clear();
+	m_y.clear();
+	m_size.clear();
+	m_sprites.clear();
+}
@@ -0,0 +1,51 @@
+#ifndef STARFIELD_H_
+#define STARFIELD_H_
+
+#include "ActorPool.h"
+#include "Coord.h"
+#include <vector>
+using namespace std;
+
+class GraphObject;
+
+const int STAR_DEPTH = 3;
+const int STARFIELD_RESERVE = 64;		// stars the field has room for before its arrays have to grow (a level starts with 30)
+
+// The background stars. They never collide or act on anything, so rather than being Actors they are kept
+// as packed arrays of positions and sizes that drift left a pixel per tick in one pass. Each star still
+// needs a GraphObject for the framework to draw; those sprites are made in a pool of their own, so once
+// the field has been full once, stars coming and going never touch the heap.
+class Starfield
+{
+public:
+	// Constructor
+	Starfield();
+	// Destructor
+	~Starfield();
+
+	// Accessors
+	int size() const;
+	double x(int i) const;
+	double y(int i) const;
+	double starSize(int i) const;
+
+	// Mutators
+	void add(double x, double y, double size);
+	void update();			// moves every star one pixel left, dropping the ones that leave the screen
+	void clear();
+
+private:
+	// no copying: the sprites belong to one field
+	Starfield(const Starfield&);
+	Starfield& operator=(const Starfield&);
+
+	void removeSprite(int i);
+
+	vector<Coord> m_x;
+	vector<Coord> m_y;
+	vector<double> m_size;		// drawing scale only, and not a multiple of .25, so never a Coord
+	vector<GraphObject*> m_sprites;		// m_sprites[i] shows star i
+	ActorPool m_spritePool;
+};
+
+#endif // STARFIELD_H_
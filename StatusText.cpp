@@ -0,0 +1,129 @@
+#include "StatusText.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+using namespace std;
+
+StatusText::StatusText()
+	: m_valid(false), m_lives(0), m_healthPercent(0), m_score(0), m_level(0), m_cabbagePercent(0), m_torpedoes(0), m_length(0)
+{
+	m_text[0] = '\0';
+}
+
+const char* StatusText::text() const
+{
+	return m_text;
+}
+
+size_t StatusText::length() const
+{
+	return m_length;
+}
+
+void StatusText::invalidate()
+{
+	m_valid = false;
+}
+
+// appends label, value and suffix to the field; the labels carry the padding setw used to add
+void StatusText::setField(int field, const char* label, long long value, const char* suffix)
+{
+	Field& f = m_fields[field];
+	size_t labelLength = strlen(label);
+	memcpy(f.text, label, labelLength);
+	char* out = f.text + labelLength;
+
+	// digits come out backwards, so build them at the end of a scratch buffer
+	char digits[24];
+	char* d = digits + sizeof(digits);
+	unsigned long long magnitude = value < 0 ? 0 - static_cast<unsigned long long>(value) : value;
+	do
+	{
+		*--d = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (value < 0)
+		*--d = '-';
+	size_t digitCount = digits + sizeof(digits) - d;
+	memcpy(out, d, digitCount);
+	out += digitCount;
+
+	size_t suffixLength = strlen(suffix);
+	memcpy(out, suffix, suffixLength);
+	f.length = out + suffixLength - f.text;
+}
+
+void StatusText::setField(int field, const char* label, double value, const char* suffix)
+{
+	// whole, non-negative numbers print the same under %.0f as under integer formatting; anything else
+	// (thirds of cabbage energy, say) goes through snprintf to round exactly as ostream's fixed did
+	if (value > -1e15 && value < 1e15 && value == static_cast<double>(static_cast<long long>(value)) && !signbit(value))
+	{
+		setField(field, label, static_cast<long long>(value), suffix);
+		return;
+	}
+	Field& f = m_fields[field];
+	int n = snprintf(f.text, FIELD_CAPACITY, "%s%.0f%s", label, value, suffix);
+	f.length = n < FIELD_CAPACITY ? n : FIELD_CAPACITY - 1;
+}
+
+// == treats 0 and -0 as equal, but they print differently
+static bool sameValue(double a, double b)
+{
+	return a == b && signbit(a) == signbit(b);
+}
+
+bool StatusText::update(unsigned int lives, double healthPercent, unsigned int score, unsigned int level,
+	double cabbagePercent, int torpedoes)
+{
+	bool changed = false;
+	if (!m_valid || lives != m_lives)
+	{
+		m_lives = lives;
+		setField(FIELD_LIVES, "Lives: ", static_cast<long long>(lives), "");
+		changed = true;
+	}
+	if (!m_valid || !sameValue(healthPercent, m_healthPercent))
+	{
+		m_healthPercent = healthPercent;
+		setField(FIELD_HEALTH, "  Health: ", healthPercent, "%");
+		changed = true;
+	}
+	if (!m_valid || score != m_score)
+	{
+		m_score = score;
+		setField(FIELD_SCORE, "  Score: ", static_cast<long long>(score), "");
+		changed = true;
+	}
+	if (!m_valid || level != m_level)
+	{
+		m_level = level;
+		setField(FIELD_LEVEL, "  Level: ", static_cast<long long>(level), "");
+		changed = true;
+	}
+	if (!m_valid || !sameValue(cabbagePercent, m_cabbagePercent))
+	{
+		m_cabbagePercent = cabbagePercent;
+		setField(FIELD_CABBAGES, " Cabbages: ", cabbagePercent, "%");
+		changed = true;
+	}
+	if (!m_valid || torpedoes != m_torpedoes)
+	{
+		m_torpedoes = torpedoes;
+		setField(FIELD_TORPEDOES, "  Torpedoes: ", static_cast<long long>(torpedoes), "");
+		changed = true;
+	}
+	m_valid = true;
+	if (!changed)
+		return false;
+
+	char* out = m_text;
+	for (int i = 0; i < NUM_FIELDS; i++)
+	{
+		memcpy(out, m_fields[i].text, m_fields[i].length);
+		out += m_fields[i].length;
+	}
+	*out = '\0';
+	m_length = out - m_text;
+	return true;
+}
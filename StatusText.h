@@ -0,0 +1,50 @@
+#ifndef STATUSTEXT_H_
+#define STATUSTEXT_H_
+
+#include <cstddef>
+
+// The status line at the top of the screen, e.g.
+//   "Lives: 3  Health: 100%  Score: 24530  Level: 3 Cabbages: 80%  Torpedoes: 4"
+// kept in a fixed buffer. Each field is formatted only when its value changes, and the line is only
+// reassembled when some field did, so a tick where nothing changed costs six comparisons.
+class StatusText
+{
+public:
+	// Constructor
+	StatusText();
+
+	// Accessors
+	const char* text() const;
+	size_t length() const;
+
+	// Mutators
+	bool update(unsigned int lives, double healthPercent, unsigned int score, unsigned int level,
+		double cabbagePercent, int torpedoes);		// true if the text changed
+	void invalidate();									// the next update rebuilds and reports every field
+
+private:
+	enum { FIELD_LIVES, FIELD_HEALTH, FIELD_SCORE, FIELD_LEVEL, FIELD_CABBAGES, FIELD_TORPEDOES, NUM_FIELDS };
+	static const int FIELD_CAPACITY = 48;		// label plus the longest number %.0f can produce for a percent
+
+	struct Field
+	{
+		char text[FIELD_CAPACITY];
+		int length;
+	};
+
+	void setField(int field, const char* label, double value, const char* suffix);
+	void setField(int field, const char* label, long long value, const char* suffix);
+
+	Field m_fields[NUM_FIELDS];
+	bool m_valid;
+	unsigned int m_lives;
+	double m_healthPercent;
+	unsigned int m_score;
+	unsigned int m_level;
+	double m_cabbagePercent;
+	int m_torpedoes;
+	char m_text[NUM_FIELDS * FIELD_CAPACITY + 1];
+	size_t m_length;
+};
+
+#endif // STATUSTEXT_H_
@@ -1,9 +1,14 @@
 #include "StudentWorld.h"
 #include "GameConstants.h"
 #include "Actor.h"
+#include "CollisionKernel.h"
+#include "InputLog.h"
 #include <string>
-#include <list>
+#include <vector>
 #include <algorithm>
+#include <random>
+#include <cstring>
+#include <cstdlib>
 using namespace std;
 
 GameWorld* createStudentWorld(string assetDir)
@@ -11,32 +16,83 @@ GameWorld* createStudentWorld(string assetDir)
 	return new StudentWorld(assetDir);
 }
 
+WorldTuning::WorldTuning()
+	: initialStars(0), maxAliensOnScreen(0), alienShipsToBeDestroyed(0), smallgonWeight(0), smoregonWeight(0), snagglegonWeight(0)
+{
+}
+
+// size of a pool slot: the largest actor that gets spawned during a level
+static size_t largestActorSize()
+{
+	size_t sizes[] = { sizeof(Explosion), sizeof(Alien),
+		sizeof(Cabbage), sizeof(Turnip), sizeof(Torpedo), sizeof(ExtraLifeGoodie), sizeof(RepairGoodie), sizeof(TorpedoGoodie) };
+	return *max_element(sizes, sizes + sizeof(sizes) / sizeof(sizes[0]));
+}
+
 StudentWorld::StudentWorld(string assetDir)
-: GameWorld(assetDir)
+: GameWorld(assetDir), m_pool(largestActorSize()), m_nachenBlaster(nullptr), m_nextSerial(0),
+	m_collisionMode(COLLIDE_PER_ACTOR), m_nextCollisionMode(COLLIDE_PER_ACTOR), m_updateThreads(0), m_spawnTiming(SPAWN_ACTS_SAME_TICK),
+	m_playSounds(true), m_buildRenderList(false), m_goodiesCollected(0), m_statusTextsSent(0), m_inputLog(nullptr), m_ownedInputLog(nullptr)
 {
+	// a real game should differ from run to run; tools that need reproducible runs call setSeed
+	random_device rd;
+	setSeed((static_cast<uint64_t>(rd()) << 32) | rd());
+	// room up front for everything a tick grows, so steady play never allocates (see tickbench's allocs/tick)
+	m_actors.reserve(ACTOR_LIST_RESERVE);
+	m_spawned.reserve(SPAWN_QUEUE_RESERVE);
+	m_deadSlots.reserve(SPAWN_QUEUE_RESERVE);
+	m_nearby.reserve(COLLISION_SCRATCH_RESERVE);
+	m_nearbyX.reserve(COLLISION_SCRATCH_RESERVE);
+	m_nearbyY.reserve(COLLISION_SCRATCH_RESERVE);
+	m_nearbyRadius.reserve(COLLISION_SCRATCH_RESERVE);
+	m_hitIndices.reserve(COLLISION_SCRATCH_RESERVE);
+	m_hits.reserve(COLLISION_SCRATCH_RESERVE);
+	m_sweep.reserve(ACTOR_LIST_RESERVE);
+
+	// NACHENBLASTER_RECORD=file records the whole game, so a bug report can come with a replay (tools/replay)
+	if (getenv("NACHENBLASTER_RECORD") != nullptr)
+	{
+		m_ownedInputLog = new InputLog;
+		recordInput(m_ownedInputLog);
+	}
+
+	// NACHENBLASTER_ALIENS=file replaces the built-in alien archetypes (see aliens.txt for the format)
+	const char* aliens = getenv("NACHENBLASTER_ALIENS");
+	if (aliens != nullptr && !m_archetypes.load(aliens))
+		cerr << "could not load alien archetypes from " << aliens << "; using the built-in ones" << endl;
+	computeLevelStats();		// init() works them out again for each level; this covers aliens made before the first
 }
 
 StudentWorld::~StudentWorld()
 {
 	cleanUp();		// calls the cleanUp function to destruct and clean up all dynamically allocated objects
+	delete m_ownedInputLog;
 }
 
 int StudentWorld::init()
 {
 	// initialize members and create NachenBlaster
 	m_numAliensOnScreen = 0;
+	m_aliensLeaving = 0;
 	m_alienShipsDestroyed = 0;
 	m_alienShipsToBeDestroyed = 6 + (4 * getLevel());
 	m_maxAliensOnScreen = 4 + (.5 * getLevel());
+	if (m_tuning.alienShipsToBeDestroyed > 0)
+		m_alienShipsToBeDestroyed = m_tuning.alienShipsToBeDestroyed;
+	if (m_tuning.maxAliensOnScreen > 0)
+		m_maxAliensOnScreen = m_tuning.maxAliensOnScreen;
+	computeLevelStats();
+	m_collisionMode = m_nextCollisionMode;
 	m_nachenBlaster = new NachenBlaster(this);
+	refreshLineOfFire();
 
 	// create 30 stars 
-	for (int i = 0; i < 30; i++)
+	int numStars = m_tuning.initialStars > 0 ? m_tuning.initialStars : 30;
+	for (int i = 0; i < numStars; i++)
 	{
 		double x = randInt(0, VIEW_WIDTH - 1);
 		double y = randInt(0, VIEW_HEIGHT - 1);
-		double size = randInt(5, 50) / 100.0;
-		addActor(new Star(this, x, y, size));
+		m_starfield.add(x, y, starSize());
 	}
 
 	// Display status text
@@ -46,8 +102,24 @@ int StudentWorld::init()
 }
 
 int StudentWorld::move()
+{
+	TRACE_TICK(m_trace);
+	TRACE_ACTOR_COUNTS(m_trace, m_store, m_starfield.size());
+	int status = tick();
+	TRACE_PHASE(m_trace, PHASE_END_OF_TICK);
+	commitSpawns();			// whatever was spawned before an early return still belongs to the world
+	flushSounds();			// and whatever was heard before one still plays
+	if (m_buildRenderList)
+		buildRenderList();
+	if (m_inputLog != nullptr)
+		m_inputLog->endTick(stateHash());
+	return status;
+}
+
+int StudentWorld::tick()
 {
 	// have NachenBlaster (if alive) and all alive actors do something 
+	TRACE_PHASE(m_trace, PHASE_PLAYER);
 	m_nachenBlaster->doSomething();
 	if (!m_nachenBlaster->isAlive())
 	{
@@ -55,34 +127,73 @@ int StudentWorld::move()
 		decLives();
 		return GWSTATUS_PLAYER_DIED;
 	}
+	refreshLineOfFire();
 
-	for (list<Actor*>::iterator p = m_actors.begin(); p != m_actors.end(); p++)
+	// spawns wait in m_spawned; with SPAWN_ACTS_SAME_TICK each batch is appended once everyone before it
+	// has acted, and acts in turn, until a pass spawns nothing.
+	// Stars move as one pass over the starfield's columns. Everything else still moves itself in its virtual
+	// doSomething, and moveTo writes the new position back to the store: in COLLIDE_PER_ACTOR each actor
+	// checks its collisions right after it moves, before the next one acts, so a separate movement pass over
+	// the projectile columns would change which hits land first.
+	TRACE_PHASE(m_trace, PHASE_ACTORS);
+	m_starfield.update();
+	if (m_updateThreads > 0 && m_collisionMode == COLLIDE_SWEEP)
+		updateActorsInParallel();
+	else
 	{
-		if ((*p)->isAlive())
+		size_t i = 0;
+		do
 		{
-			(*p)->doSomething();
-
-			if (!m_nachenBlaster->isAlive())
+			for (; i < m_actors.size(); i++)
 			{
-				// if Nachenblaster dies in this tick, decrement lives and return that the player died
-				decLives();
-				return GWSTATUS_PLAYER_DIED;
-			}
+				Actor* p = m_actors[i];
+				if (p->isAlive())
+				{
+					p->doSomething();
 
-			// check that current level is completed
-			if (m_alienShipsDestroyed >= m_alienShipsToBeDestroyed)
-			{
-				playSound(SOUND_FINISHED_LEVEL);
-				return GWSTATUS_FINISHED_LEVEL;
+					if (!m_nachenBlaster->isAlive())
+					{
+						// if Nachenblaster dies in this tick, decrement lives and return that the player died
+						decLives();
+						return GWSTATUS_PLAYER_DIED;
+					}
+
+					// check that current level is completed
+					if (m_alienShipsDestroyed >= m_alienShipsToBeDestroyed)
+					{
+						emitSound(SOUND_FINISHED_LEVEL);
+						return GWSTATUS_FINISHED_LEVEL;
+					}
+				}
 			}
+		} while (m_spawnTiming == SPAWN_ACTS_SAME_TICK && commitSpawns());
+	}
+	commitSpawns();		// SPAWN_ACTS_NEXT_TICK: they join now and first act next tick
+
+	// in sweep mode nobody collided while moving; do it all now
+	if (m_collisionMode == COLLIDE_SWEEP)
+	{
+		TRACE_PHASE(m_trace, PHASE_COLLISIONS);
+		resolveCollisions();
+		if (!m_nachenBlaster->isAlive())
+		{
+			decLives();
+			return GWSTATUS_PLAYER_DIED;
+		}
+		if (m_alienShipsDestroyed >= m_alienShipsToBeDestroyed)
+		{
+			emitSound(SOUND_FINISHED_LEVEL);
+			return GWSTATUS_FINISHED_LEVEL;
 		}
-			
 	}
 
 	// 1/15 chance of introducing new Star
+	TRACE_PHASE(m_trace, PHASE_SPAWN);
 	if (randInt(1, 15) == 1)
 	{
-		addActor(new Star(this, VIEW_WIDTH - 1, randInt(0, VIEW_HEIGHT - 1), randInt(5, 50) / 100.0));
+		// draw y before size explicitly; argument evaluation order would make runs compiler-dependent
+		int y = randInt(0, VIEW_HEIGHT - 1);
+		m_starfield.add(VIEW_WIDTH - 1, y, starSize());
 	}
 
 	// if the number of aliens on screen are less than the minimum of the max # vs the remaining # of ships to destroy
@@ -91,25 +202,16 @@ int StudentWorld::move()
 	{
 		int addAlien = decideShipToAdd();
 		int yCoord = randInt(0, VIEW_HEIGHT - 1);
-		switch (addAlien)
-		{
-		case ADD_SMALLGON:
-			addActor(new Smallgon(this, VIEW_WIDTH - 1, yCoord));
-			break;
-		case ADD_SMOREGON:
-			addActor(new Smoregon(this, VIEW_WIDTH - 1, yCoord));
-			break;
-		case ADD_SNAGGLEGON:
-			addActor(new Snagglegon(this, VIEW_WIDTH - 1, yCoord));
-			break;
-		}
+		addActor(new (m_pool) Alien(this, VIEW_WIDTH - 1, yCoord, m_archetypes.get(addAlien)));
 		m_numAliensOnScreen++;
 	}
 
 	// delete any dead actors
+	TRACE_PHASE(m_trace, PHASE_CLEANUP);
 	deleteDeadActors();
 
 	// update the status text at top
+	TRACE_PHASE(m_trace, PHASE_STATUS);
 	updateStatusText();
 
 	return GWSTATUS_CONTINUE_GAME;
@@ -117,40 +219,89 @@ int StudentWorld::move()
 }
 
 void StudentWorld::cleanUp()
+{
+	// the recording so far, rewritten at every death and level, so a crash or a killed game still leaves one behind
+	if (m_ownedInputLog != nullptr)
+	{
+		const char* path = getenv("NACHENBLASTER_RECORD");
+		if (path == nullptr || !m_ownedInputLog->save(path))
+			cerr << "could not save the input recording" << endl;
+	}
+	clearLevel();
+}
+
+void StudentWorld::clearLevel()
 {
 	// deletes dynamically allocated player
 	delete m_nachenBlaster;
 	m_nachenBlaster = nullptr;
 
 	// deletes all dynamically allocated actors
-	for (list<Actor*>::iterator p = m_actors.begin(); p != m_actors.end();)
+	commitSpawns();
+	for (vector<Actor*>::iterator p = m_actors.begin(); p != m_actors.end(); p++)
 	{
 		delete *p;
 		*p = nullptr;
-		p = m_actors.erase(p);
 	}
+	m_actors.clear();
+	m_starfield.clear();
+	m_lineOfFire.clear();
+	m_sounds.clear();		// anything emitted outside move() dies with the level
+	m_aliensLeaving = 0;
+	m_store.clear();
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+		m_grids[i].clear();
+	m_statusText.invalidate();		// so the next level's text is sent even if it reads the same
 }
 
 int StudentWorld::decideShipToAdd()
 {
-	int S1 = 60;
-	int S2 = 20 + getLevel() * 5;
-	int S3 = 5 + getLevel() * 10;
-	int S = S1 + S2 + S3;
+	int chance = randInt(1, m_levelStats.back().spawnWeightUpTo);
 
-	int chance = randInt(1, S);
+	// each archetype owns the numbers above the previous archetype's spawnWeightUpTo, up to its own
+	int last = 0;
+	while (chance > m_levelStats[last].spawnWeightUpTo)
+		last++;
+	return last;
+}
 
-	// set boundaries for the probability
-	int smallgonProb = S1;
-	int smoregonProb = S1 + S2;
-	int snagglegonProb = S;
+int StudentWorld::shipWeight(int archetype) const
+{
+	int tuned[] = { m_tuning.smallgonWeight, m_tuning.smoregonWeight, m_tuning.snagglegonWeight };
+	if (archetype < 3 && tuned[archetype] > 0)
+		return tuned[archetype];
+	const AlienArchetype& a = m_archetypes.get(archetype);
+	return a.weight + getLevel() * a.weightPerLevel;
+}
 
-	if (chance <= smallgonProb)
-		return ADD_SMALLGON;
-	else if (chance > smallgonProb && chance <= smoregonProb)
-		return ADD_SMOREGON;
-	else
-		return ADD_SNAGGLEGON;
+void StudentWorld::computeLevelStats()
+{
+	unsigned int level = getLevel();
+	unsigned int divisor = level > 0 ? level : 1;		// the framework starts at level 0 until the first advanceToNextLevel
+	m_levelStats.resize(m_archetypes.size());
+	int weightUpTo = 0;
+	for (int i = 0; i < m_archetypes.size(); i++)
+	{
+		const AlienArchetype& a = m_archetypes.get(i);
+		AlienLevelStats& s = m_levelStats[i];
+		s.hitPoints = a.hitPoints * (1 + (level - 1) * a.hitPointsPerLevel);
+		s.fireRange = a.fireNumerator / divisor + a.fireBase;
+		weightUpTo += shipWeight(i);
+		s.spawnWeightUpTo = weightUpTo;
+	}
+}
+
+const AlienLevelStats& StudentWorld::alienLevelStats(int archetype) const
+{
+	return m_levelStats[archetype];
+}
+
+double StudentWorld::starSize()
+{
+	// Star's constructor used to draw a second size over the one it was given; both draws are
+	// kept so that seeded games go on exactly as they did
+	randInt(5, 50);
+	return randInt(5, 50) / 100.0;
 }
 
 void StudentWorld::recordAlienDestroyed()
@@ -168,70 +319,418 @@ void StudentWorld::increaseTorpedoes()
 	m_nachenBlaster->increaseTorpedoes(5);
 }
 
+Actor* StudentWorld::createActor(int kind, double x, double y)
+{
+	switch (kind)
+	{
+	case SPAWN_CABBAGE:
+		return new (m_pool) Cabbage(this, x, y);
+	case SPAWN_NB_TORPEDO:
+		return new (m_pool) Torpedo(this, x, y, 0);
+	case SPAWN_TURNIP:
+		return new (m_pool) Turnip(this, x, y);
+	case SPAWN_ALIEN_TORPEDO:
+		return new (m_pool) Torpedo(this, x, y, 180);
+	case SPAWN_EXPLOSION:
+		return new (m_pool) Explosion(this, x, y);
+	case SPAWN_REPAIR_GOODIE:
+		return new (m_pool) RepairGoodie(this, x, y);
+	case SPAWN_TORPEDO_GOODIE:
+		return new (m_pool) TorpedoGoodie(this, x, y);
+	case SPAWN_EXTRA_LIFE_GOODIE:
+		return new (m_pool) ExtraLifeGoodie(this, x, y);
+	default:
+		return new (m_pool) Alien(this, x, y, m_archetypes.get(kind - SPAWN_ALIEN));
+	}
+}
+
+void StudentWorld::spawnActor(int kind, double x, double y)
+{
+	UpdateWorker* w = currentWorker(this);
+	if (w != nullptr)
+	{
+		TickCommand c = { kind, 0, x, y };
+		w->commands->push_back(c);
+	}
+	else
+	{
+		Actor* a = createActor(kind, x, y);
+		registerActor(a);
+		m_spawned.push_back(a);
+	}
+}
+
+void StudentWorld::emitSound(int soundID)
+{
+	UpdateWorker* w = currentWorker(this);
+	if (w != nullptr)
+	{
+		TickCommand c = { COMMAND_SOUND, soundID, 0, 0 };
+		w->commands->push_back(c);
+	}
+	else
+		m_sounds.add(soundID);
+}
+
+void StudentWorld::setSoundVoices(int voices)
+{
+	m_sounds.setVoicesPerSound(voices);
+}
+
+void StudentWorld::setPlaySounds(bool play)
+{
+	m_playSounds = play;
+}
+
+void StudentWorld::setBuildRenderList(bool build)
+{
+	m_buildRenderList = build;
+}
+
+RenderList& StudentWorld::renderList()
+{
+	return m_renderList;
+}
+
+void StudentWorld::buildRenderList()
+{
+	m_renderList.begin();
+	for (int i = 0; i < m_starfield.size(); i++)
+		m_renderList.add(IID_STAR, STAR_DEPTH, m_starfield.x(i), m_starfield.y(i), m_starfield.starSize(i), 0);
+	for (vector<Actor*>::const_iterator p = m_actors.begin(); p != m_actors.end(); p++)
+	{
+		const Actor* a = *p;
+		if (a->isAlive())
+			m_renderList.add(a->imageID(), a->depth(), a->getX(), a->getY(), a->getSize(), a->getDirection());
+	}
+	const Actor* nb = m_nachenBlaster;
+	m_renderList.add(nb->imageID(), nb->depth(), nb->getX(), nb->getY(), nb->getSize(), nb->getDirection());
+	m_renderList.publish();
+}
+
+void StudentWorld::flushSounds()
+{
+	if (m_playSounds)
+	{
+		for (int i = 0; i < m_sounds.size(); i++)
+			playSound(m_sounds.soundAt(i));
+	}
+	m_sounds.clear();
+}
+
 void StudentWorld::addActor(Actor* a)
 {
+	registerActor(a);
 	m_actors.push_back(a);
 }
 
+bool StudentWorld::commitSpawns()
+{
+	if (m_spawned.empty())
+		return false;
+	m_actors.insert(m_actors.end(), m_spawned.begin(), m_spawned.end());
+	m_spawned.clear();
+	return true;
+}
+
+void StudentWorld::registerActor(Actor* a)
+{
+	TRACE_COUNT(m_trace, actorsAdded, 1);
+	ActorHandle h = m_store.add(a, m_nextSerial++);
+	a->setHandle(h);
+
+	if (hasGrid(h.category))
+		m_store.setCell(h, m_grids[h.category].insert(h, a->getX(), a->getY(), a->getRadius()));
+}
+
+bool StudentWorld::hasGrid(int category) const
+{
+	// goodies only ever touch the NachenBlaster, which they test against directly,
+	// and explosions never collide with anything. The sweep does not use the grids at all.
+	if (m_collisionMode == COLLIDE_SWEEP)
+		return false;
+	return category == CATEGORY_ALIEN || category == CATEGORY_NB_PROJECTILE || category == CATEGORY_ALIEN_PROJECTILE;
+}
+
+ActorPool& StudentWorld::actorPool()
+{
+	return m_pool;
+}
+
+void StudentWorld::setSeed(uint64_t seed)
+{
+	m_seed = seed;
+	m_rng.seed(seed);
+}
+
+void StudentWorld::recordInput(InputLog* log)
+{
+	m_inputLog = log;
+	if (log == nullptr)
+		return;
+	InputLog::Setup setup;
+	setup.seed = m_seed;
+	setup.level = getLevel();
+	setup.lives = getLives();
+	setup.collisionMode = m_nextCollisionMode;
+	setup.spawnTiming = m_spawnTiming;
+	setup.parallelUpdate = m_updateThreads > 0;
+	setup.archetypesHash = m_archetypes.hash();
+	setup.tuning = m_tuning;
+	log->start(setup);
+}
+
+bool StudentWorld::readKey(int& value)
+{
+	bool pressed = getKey(value);
+	if (m_inputLog != nullptr)
+		m_inputLog->addKey(pressed ? value : NO_KEY);
+	return pressed;
+}
+
+// FNV-1a over the bytes of each value
+static void hashBytes(uint64_t& h, const void* data, size_t n)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < n; i++)
+		h = (h ^ p[i]) * 1099511628211ULL;
+}
+
+uint32_t StudentWorld::alienArchetypesHash() const
+{
+	return m_archetypes.hash();
+}
+
+uint32_t StudentWorld::stateHash() const
+{
+	uint64_t h = 14695981039346656037ULL;
+	unsigned int counters[] = { getLevel(), getLives(), getScore(), static_cast<unsigned int>(m_alienShipsDestroyed),
+		static_cast<unsigned int>(m_numAliensOnScreen), m_nextSerial };
+	hashBytes(h, counters, sizeof(counters));
+	uint64_t rng = m_rng.state();
+	hashBytes(h, &rng, sizeof(rng));
+
+	// the same records a snapshot holds, so anything a snapshot restores is covered
+	ActorRecord r;
+	if (m_nachenBlaster != nullptr)
+	{
+		memset(&r, 0, sizeof(r));
+		m_nachenBlaster->save(r);
+		hashBytes(h, &r, sizeof(r));
+	}
+	for (vector<Actor*>::const_iterator p = m_actors.begin(); p != m_actors.end(); p++)
+	{
+		memset(&r, 0, sizeof(r));
+		(*p)->save(r);
+		hashBytes(h, &r, sizeof(r));
+	}
+	for (int i = 0; i < m_starfield.size(); i++)
+	{
+		double star[] = { m_starfield.x(i), m_starfield.y(i), m_starfield.starSize(i) };
+		hashBytes(h, star, sizeof(star));
+	}
+	return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+int StudentWorld::randInt(int min, int max)
+{
+	UpdateWorker* w = currentWorker(this);
+	if (w != nullptr)
+		return w->rng.randInt(min, max);
+	return m_rng.randInt(min, max);
+}
+
+#ifdef INSTRUMENT_TICKS
+TickTrace& StudentWorld::tickTrace()
+{
+	return m_trace;
+}
+#endif
+
+void StudentWorld::setUpdateThreads(int n)
+{
+	m_updateThreads = max(n, 0);
+	m_threads.setWorkers(max(n - 1, 0));		// the thread calling move() is the other one
+}
+
+void StudentWorld::setCollisionMode(int mode)
+{
+	// the grids are only kept up in COLLIDE_PER_ACTOR, so the mode cannot change in the middle of a level
+	m_nextCollisionMode = mode;
+}
+
+void StudentWorld::setSpawnTiming(int timing)
+{
+	m_spawnTiming = timing;
+}
+
+void StudentWorld::setTuning(const WorldTuning& tuning)
+{
+	m_tuning = tuning;
+}
+
+int StudentWorld::numActors() const
+{
+	return m_actors.size();
+}
+
+unsigned long StudentWorld::goodiesCollected() const
+{
+	return m_goodiesCollected;
+}
+
+void StudentWorld::actorMoved(Actor* a)
+{
+	ActorHandle h = a->handle();
+	if (h.slot < 0)				// the NachenBlaster is not in the store
+		return;
+	m_store.setPosition(h, a->getX(), a->getY());
+	if (hasGrid(h.category))
+		m_store.setCell(h, m_grids[h.category].update(h, m_store.cellOf(h), a->getX(), a->getY()));
+}
+
+void StudentWorld::actorDied(Actor* a)
+{
+	ActorHandle h = a->handle();
+	if (h.slot < 0 || !m_store.isAlive(h))		// the NachenBlaster, or an actor that was already dead
+		return;
+	m_store.setDead(h);
+	if (h.category != CATEGORY_ALIEN)
+		return;
+	UpdateWorker* w = currentWorker(this);
+	if (w != nullptr)
+	{
+		TickCommand c = { COMMAND_ALIEN_LEFT, 0, 0, 0 };
+		w->commands->push_back(c);
+	}
+	else
+		m_aliensLeaving++;
+}
+
 void StudentWorld::deleteDeadActors()
 {
-	for (list<Actor*>::iterator p = m_actors.begin(); p != m_actors.end();)
+	m_numAliensOnScreen -= m_aliensLeaving;
+	m_aliensLeaving = 0;
+
+	// compact m_actors in place, keeping survivors in the order they act; the dead are destroyed
+	// on the way and their slots handed back to the pool together at the end
+	vector<Actor*>::iterator out = m_actors.begin();
+	for (vector<Actor*>::iterator p = m_actors.begin(); p != m_actors.end(); p++)
 	{
-		if ((*p)->isAlive() == false)
+		Actor* a = *p;
+		if (a->isAlive())
 		{
-			if ((*p)->isAlien())
-				m_numAliensOnScreen--;
-			delete *p;
-			p = m_actors.erase(p);
+			*out++ = a;
+			continue;
 		}
-		else
-			p++;
+		ActorHandle h = a->handle();
+		if (hasGrid(h.category))
+			m_grids[h.category].remove(h, m_store.cellOf(h));
+		m_store.remove(h);
+		m_deadSlots.push_back(dynamic_cast<void*>(a));		// the start of the whole object, which is what the pool handed out
+		a->~Actor();
+		TRACE_COUNT(m_trace, actorsDeleted, 1);
 	}
+	m_actors.erase(out, m_actors.end());
+	m_pool.releaseAll(m_deadSlots);
+	m_deadSlots.clear();
 }
 
 bool StudentWorld::playerInLineOfFire(const Actor* a) const
 {
-	if (m_nachenBlaster->getX() < a->getX() && m_nachenBlaster->getY() <= a->getY() + 4 &&
-		m_nachenBlaster->getY() >= a->getY() - 4)
-		return true;
-	return false;
+	return m_lineOfFire.covers(a->getX(), a->getY());
 }
 
-double StudentWorld::euclidean_dist(double x1, double y1, double x2, double y2) const
+int StudentWorld::aliensInLineOfFire(vector<Actor*>& out)
 {
-	return sqrt((x2 - x1)*(x2 - x1) + (y2 - y1)*(y2 - y1));
+	return m_lineOfFire.shooters(m_store.columns(CATEGORY_ALIEN), out);
+}
+
+void StudentWorld::refreshLineOfFire()
+{
+	m_lineOfFire.refresh(m_nachenBlaster->getX(), m_nachenBlaster->getY());
 }
 
 bool StudentWorld::isCollision(const Actor* a, const Actor* p) const
 {
-	if (euclidean_dist(a->getX(), a->getY(), p->getX(), p->getY()) < .75 * (a->getRadius() + p->getRadius()))
-		return true;
-	return false;
+	return circlesCollide(a->getX(), a->getY(), a->getRadius(), p->getX(), p->getY(), p->getRadius());
+}
+
+bool StudentWorld::earlierSerial(const Hit& a, const Hit& b)
+{
+	return a.serial < b.serial;
+}
+
+void StudentWorld::findHits(const Actor* a, int categoryMask)
+{
+	// broad phase: nearby actors, only from the partitions a can actually hit
+	m_nearby.clear();
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+	{
+		if ((categoryMask & (1 << i)) && hasGrid(i))
+			m_grids[i].query(a->getX(), a->getY(), a->getRadius(), m_nearby);
+	}
+
+	// pack their positions and radii out of the store columns for the kernel
+	int n = m_nearby.size();
+	m_nearbyX.resize(n);
+	m_nearbyY.resize(n);
+	m_nearbyRadius.resize(n);
+	m_hitIndices.resize(n);
+	for (int i = 0; i < n; i++)
+	{
+		const ActorColumns& c = m_store.columns(m_nearby[i].category);
+		int row = m_store.indexOf(m_nearby[i]);
+		m_nearbyX[i] = c.x[row];
+		m_nearbyY[i] = c.y[row];
+		m_nearbyRadius[i] = c.radius[row];
+	}
+
+	// narrow phase
+	m_hits.clear();
+	if (n == 0)
+		return;
+	int numHits = findCollisions(toCoord(a->getX()), toCoord(a->getY()), toCoord(a->getRadius()), &m_nearbyX[0], &m_nearbyY[0], &m_nearbyRadius[0], n, &m_hitIndices[0]);
+	TRACE_COUNT(m_trace, pairsTested, n);		// hits are counted by the caller, only when they are applied
+	for (int i = 0; i < numHits; i++)
+	{
+		ActorHandle h = m_nearby[m_hitIndices[i]];
+		Hit hit = { m_store.columns(h.category).serial[m_store.indexOf(h)], h };
+		m_hits.push_back(hit);
+	}
+
+	// the grid hands back cells in spatial order; sort by serial so hits are applied in the
+	// same order as a scan of m_actors would apply them
+	sort(m_hits.begin(), m_hits.end(), earlierSerial);
 }
 
 void StudentWorld::checkCollision(Actor* a)
 {
+	// in sweep mode collisions are resolved once per tick by resolveCollisions
+	if (m_collisionMode == COLLIDE_SWEEP)
+		return;
+	TRACE_COUNT(m_trace, collisionChecks, 1);
+
 	// if the passed in actor is a NachenBlaster, check for collisions with aliens or projectiles that Aliens fire
 	if (a == m_nachenBlaster)
 	{
-		for (list<Actor*>::const_iterator p = m_actors.begin(); p != m_actors.end(); p++)
+		findHits(a, (1 << CATEGORY_ALIEN) | (1 << CATEGORY_ALIEN_PROJECTILE));
+		for (vector<Hit>::const_iterator p = m_hits.begin(); p != m_hits.end(); p++)
 		{
-			if ((*p)->isAlive() && isCollision(a, *p))
+			if (m_store.isAlive(p->handle))
 			{
-				if ((*p)->isAlien())
+				TRACE_COUNT(m_trace, hits, 1);
+				if (p->handle.category == CATEGORY_ALIEN)
 				{
-					Alien* al = static_cast<Alien*>(*p);
+					Alien* al = static_cast<Alien*>(m_store.actorAt(p->handle));
 					al->sufferDamage(0, HIT_BY_SHIP);
 					m_nachenBlaster->sufferDamage(al->getDamageAmt(), HIT_BY_SHIP);
 				}
-				if ((*p)->isProjectile())
+				if (p->handle.category == CATEGORY_ALIEN_PROJECTILE)
 				{
-					Projectile* pr = static_cast<Projectile*>(*p);
-					if (pr->firedFromAlien())
-					{
-						m_nachenBlaster->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
-						pr->setDead();
-					}
+					Projectile* pr = static_cast<Projectile*>(m_store.actorAt(p->handle));
+					m_nachenBlaster->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
+					pr->setDead();
 				}
 			}
 		}
@@ -241,23 +740,24 @@ void StudentWorld::checkCollision(Actor* a)
 	if (a->isAlien())
 	{
 		Alien* al = static_cast<Alien*>(a);
+		TRACE_COUNT(m_trace, pairsTested, 1);
 		if (isCollision(al, m_nachenBlaster))
 		{
+			TRACE_COUNT(m_trace, hits, 1);
 			m_nachenBlaster->sufferDamage(al->getDamageAmt(), HIT_BY_SHIP);
 			al->sufferDamage(0, HIT_BY_SHIP);
 			
 		}
 
-		for (list<Actor*>::const_iterator p = m_actors.begin(); p != m_actors.end(); p++)
+		findHits(al, 1 << CATEGORY_NB_PROJECTILE);
+		for (vector<Hit>::const_iterator p = m_hits.begin(); p != m_hits.end(); p++)
 		{
-			if ((*p)->isProjectile() && isCollision(al, *p) && (*p)->isAlive())
+			if (m_store.isAlive(p->handle))
 			{
-				Projectile* pr = static_cast<Projectile*>(*p);
-				if (pr->firedFromNB())
-				{
-					al->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
-					pr->setDead();
-				}
+				TRACE_COUNT(m_trace, hits, 1);
+				Projectile* pr = static_cast<Projectile*>(m_store.actorAt(p->handle));
+				al->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
+				pr->setDead();
 			}
 		}
 	}
@@ -266,18 +766,23 @@ void StudentWorld::checkCollision(Actor* a)
 	if (a->isProjectile())
 	{
 		Projectile* pr = static_cast<Projectile*>(a);
+		TRACE_COUNT(m_trace, pairsTested, 1);
 		if (isCollision(pr, m_nachenBlaster) && pr->firedFromAlien())
 		{
+			TRACE_COUNT(m_trace, hits, 1);
 			m_nachenBlaster->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
 			pr->setDead();
 		}
-		for (list<Actor*>::const_iterator p = m_actors.begin(); p != m_actors.end(); p++)
+		// only the NachenBlaster's projectiles can hurt aliens
+		if (pr->firedFromNB())
 		{
-			if ((*p)->isAlien() && (*p)->isAlive() && isCollision(pr, *p))
+			findHits(pr, 1 << CATEGORY_ALIEN);
+			for (vector<Hit>::const_iterator p = m_hits.begin(); p != m_hits.end(); p++)
 			{
-				if (pr->firedFromNB())
+				if (m_store.isAlive(p->handle))
 				{
-					Alien* al = static_cast<Alien*>(*p);
+					TRACE_COUNT(m_trace, hits, 1);
+					Alien* al = static_cast<Alien*>(m_store.actorAt(p->handle));
 					al->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
 					pr->setDead();
 				}
@@ -289,27 +794,365 @@ void StudentWorld::checkCollision(Actor* a)
 	// if a is a goodie, only check for collisions with the NachenBlaster
 	if (a->isGoodie())
 	{
+		TRACE_COUNT(m_trace, pairsTested, 1);
 		if (isCollision(a, m_nachenBlaster))
 		{
+			TRACE_COUNT(m_trace, hits, 1);
 			Goodie* gd = static_cast<Goodie*>(a);
 			increaseScore(100);
+			m_goodiesCollected++;
+			gd->giveGoodie();
+			gd->setDead();
+		}
+	}
+}
+
+// the NachenBlaster is not in the actor store, so it gets a category of its own in the sweep
+const int SWEEP_NACHENBLASTER = NUM_CATEGORIES;
+
+int StudentWorld::targetsOf(int category)
+{
+	switch (category)
+	{
+	case SWEEP_NACHENBLASTER:
+		return (1 << CATEGORY_ALIEN) | (1 << CATEGORY_ALIEN_PROJECTILE) | (1 << CATEGORY_GOODIE);
+	case CATEGORY_ALIEN:
+		return (1 << SWEEP_NACHENBLASTER) | (1 << CATEGORY_NB_PROJECTILE);
+	case CATEGORY_NB_PROJECTILE:
+		return 1 << CATEGORY_ALIEN;
+	case CATEGORY_ALIEN_PROJECTILE:
+	case CATEGORY_GOODIE:
+		return 1 << SWEEP_NACHENBLASTER;
+	default:
+		return 0;
+	}
+}
+
+bool StudentWorld::sweepsBefore(const SweepEntry& a, const SweepEntry& b)
+{
+	// ties are broken on serial and category so the pair order never depends on the sort
+	if (a.minX != b.minX)
+		return a.minX < b.minX;
+	if (a.serial != b.serial)
+		return a.serial < b.serial;
+	return a.category < b.category;
+}
+
+void StudentWorld::resolveCollisions()
+{
+	// collect every live actor that can collide with something
+	m_sweep.clear();
+	SweepEntry nb = { m_nachenBlaster->getX() - .75 * m_nachenBlaster->getRadius(), m_nachenBlaster->getX() + .75 * m_nachenBlaster->getRadius(),
+		m_nachenBlaster->getX(), m_nachenBlaster->getY(), m_nachenBlaster->getRadius(), 0, SWEEP_NACHENBLASTER, m_nachenBlaster };
+	m_sweep.push_back(nb);
+	for (int category = 0; category < NUM_CATEGORIES; category++)
+	{
+		if (targetsOf(category) == 0)
+			continue;
+		const ActorColumns& c = m_store.columns(category);
+		for (int row = 0; row < m_store.size(category); row++)
+		{
+			if (!c.alive[row])
+				continue;
+			double x = toDouble(c.x[row]);
+			double radius = toDouble(c.radius[row]);
+			double reach = .75 * radius;
+			SweepEntry e = { x - reach, x + reach, x, toDouble(c.y[row]), radius, c.serial[row], category, c.actor[row] };
+			m_sweep.push_back(e);
+		}
+	}
+
+	// two actors can only collide if their x extents overlap: dist < .75 * (rA + rB) needs |dx| < .75 * rA + .75 * rB
+	sort(m_sweep.begin(), m_sweep.end(), sweepsBefore);
+	for (size_t i = 0; i < m_sweep.size(); i++)
+	{
+		const SweepEntry& a = m_sweep[i];
+		int targets = targetsOf(a.category);
+		for (size_t j = i + 1; j < m_sweep.size() && m_sweep[j].minX < a.maxX; j++)
+		{
+			const SweepEntry& b = m_sweep[j];
+			if ((targets & (1 << b.category)) == 0)
+				continue;
+			TRACE_COUNT(m_trace, pairsTested, 1);
+			if (circlesCollide(a.x, a.y, a.radius, b.x, b.y, b.radius))
+				resolvePair(a.actor, a.category, b.actor, b.category);
+		}
+	}
+}
+
+void StudentWorld::resolvePair(Actor* a, int categoryA, Actor* b, int categoryB)
+{
+	// each pair is handled once, so an actor killed by an earlier pair this tick takes no further part
+	if (!a->isAlive() || !b->isAlive())
+		return;
+	TRACE_COUNT(m_trace, hits, 1);
+
+	// put the NachenBlaster, then the alien, first
+	if (categoryB == SWEEP_NACHENBLASTER || (categoryB == CATEGORY_ALIEN && categoryA != SWEEP_NACHENBLASTER))
+	{
+		swap(a, b);
+		swap(categoryA, categoryB);
+	}
+
+	if (categoryA == SWEEP_NACHENBLASTER)
+	{
+		if (categoryB == CATEGORY_ALIEN)
+		{
+			Alien* al = static_cast<Alien*>(b);
+			al->sufferDamage(0, HIT_BY_SHIP);
+			m_nachenBlaster->sufferDamage(al->getDamageAmt(), HIT_BY_SHIP);
+		}
+		else if (categoryB == CATEGORY_ALIEN_PROJECTILE)
+		{
+			Projectile* pr = static_cast<Projectile*>(b);
+			m_nachenBlaster->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
+			pr->setDead();
+		}
+		else if (categoryB == CATEGORY_GOODIE)
+		{
+			Goodie* gd = static_cast<Goodie*>(b);
+			increaseScore(100);
+			m_goodiesCollected++;
 			gd->giveGoodie();
 			gd->setDead();
 		}
 	}
+	else if (categoryA == CATEGORY_ALIEN && categoryB == CATEGORY_NB_PROJECTILE)
+	{
+		Projectile* pr = static_cast<Projectile*>(b);
+		static_cast<Alien*>(a)->sufferDamage(pr->getDmgAmt(), HIT_BY_PROJECTILE);
+		pr->setDead();
+	}
+}
+
+thread_local StudentWorld::UpdateWorker* StudentWorld::s_worker = nullptr;
+
+StudentWorld::UpdateWorker* StudentWorld::currentWorker(const StudentWorld* world)
+{
+	// another world may be updating on this thread's behalf only if it is this one
+	if (s_worker != nullptr && s_worker->world == world)
+		return s_worker;
+	return nullptr;
+}
+
+StudentWorld::ActorUpdate::ActorUpdate(StudentWorld* world, size_t begin, size_t end, uint64_t tickSeed)
+	: m_world(world), m_begin(begin), m_end(end), m_tickSeed(tickSeed)
+{
+}
+
+void StudentWorld::ActorUpdate::runTask(int chunk)
+{
+	UpdateWorker w;
+	w.world = m_world;
+	w.commands = &m_world->m_chunkCommands[chunk];
+	s_worker = &w;
+
+	size_t first = m_begin + chunk * UPDATE_CHUNK_SIZE;
+	size_t last = min(first + UPDATE_CHUNK_SIZE, m_end);
+	for (size_t i = first; i < last; i++)
+	{
+		Actor* a = m_world->m_actors[i];
+		if (!a->isAlive())
+			continue;
+
+		// the actor's random numbers depend on the tick and on the actor, never on which thread runs it
+		ActorHandle h = a->handle();
+		w.rng.seed(m_tickSeed, m_world->m_store.columns(h.category).serial[m_world->m_store.indexOf(h)]);
+		a->doSomething();
+	}
+
+	s_worker = nullptr;
+}
+
+void StudentWorld::updateActorsInParallel()
+{
+	// With COLLIDE_SWEEP nothing collides during the update, so an actor only touches its own state and
+	// its own row of the store, and only reads the NachenBlaster, which has already moved. Everything
+	// else it does (spawning, sounds, random numbers) goes through the worker set up by runTask.
+	uint64_t tickSeed = (static_cast<uint64_t>(m_rng.next()) << 32) | m_rng.next();
+
+	// with SPAWN_ACTS_SAME_TICK, each round's spawns are committed and act in another round, as in the
+	// in-order update; with SPAWN_ACTS_NEXT_TICK they stay queued and there is only the one round
+	size_t begin = 0;
+	while (begin < m_actors.size())
+	{
+		size_t end = m_actors.size();
+		int numChunks = (end - begin + UPDATE_CHUNK_SIZE - 1) / UPDATE_CHUNK_SIZE;
+		while (m_chunkCommands.size() < static_cast<size_t>(numChunks))
+		{
+			m_chunkCommands.push_back(vector<TickCommand>());
+			m_chunkCommands.back().reserve(SPAWN_QUEUE_RESERVE);		// workers push from other threads; growing there would allocate mid-tick
+		}
+
+		ActorUpdate update(this, begin, end, tickSeed);
+		m_threads.run(update, numChunks);
+
+		// apply the queued commands in actor order, whatever order the chunks finished in
+		for (int chunk = 0; chunk < numChunks; chunk++)
+		{
+			vector<TickCommand>& commands = m_chunkCommands[chunk];
+			for (vector<TickCommand>::const_iterator c = commands.begin(); c != commands.end(); c++)
+			{
+				if (c->kind == COMMAND_SOUND)
+					m_sounds.add(c->soundID);
+				else if (c->kind == COMMAND_ALIEN_LEFT)
+					m_aliensLeaving++;
+				else
+					spawnActor(c->kind, c->x, c->y);
+			}
+			commands.clear();
+		}
+		if (m_spawnTiming == SPAWN_ACTS_SAME_TICK)
+			commitSpawns();
+		begin = end;
+	}
+}
+
+const unsigned int SNAPSHOT_MAGIC = 0x3153424e;		// "NBS1"
+const unsigned int SNAPSHOT_VERSION = 3;		// 2 did not hash the alien table
+
+void StudentWorld::saveSnapshot(vector<unsigned char>& out) const
+{
+	SnapshotHeader h;
+	memset(&h, 0, sizeof(h));
+	h.magic = SNAPSHOT_MAGIC;
+	h.version = SNAPSHOT_VERSION;
+	h.level = getLevel();
+	h.lives = getLives();
+	h.score = getScore();
+	h.collisionMode = m_collisionMode;
+	h.archetypesHash = m_archetypes.hash();
+	h.rngState = m_rng.state();
+	h.rngStream = m_rng.stream();
+	h.nextSerial = m_nextSerial;
+	h.alienShipsDestroyed = m_alienShipsDestroyed;
+	h.alienShipsToBeDestroyed = m_alienShipsToBeDestroyed;
+	h.maxAliensOnScreen = m_maxAliensOnScreen;
+	h.numAliensOnScreen = m_numAliensOnScreen;
+	h.goodiesCollected = m_goodiesCollected;
+	h.numActors = m_actors.size();
+	h.numStars = m_starfield.size();
+
+	// records are fixed-size and written straight into the buffer, NachenBlaster first
+	size_t starsAt = sizeof(h) + (m_actors.size() + 1) * sizeof(ActorRecord);
+	out.resize(starsAt + m_starfield.size() * sizeof(StarRecord));
+	memcpy(&out[0], &h, sizeof(h));
+	ActorRecord* records = reinterpret_cast<ActorRecord*>(&out[sizeof(h)]);
+	memset(records, 0, (m_actors.size() + 1) * sizeof(ActorRecord));
+	m_nachenBlaster->save(records[0]);
+	for (size_t i = 0; i < m_actors.size(); i++)
+	{
+		ActorHandle handle = m_actors[i]->handle();
+		m_actors[i]->save(records[i + 1]);
+		records[i + 1].serial = m_store.columns(handle.category).serial[m_store.indexOf(handle)];
+	}
+	StarRecord* stars = reinterpret_cast<StarRecord*>(&out[starsAt]);
+	for (int i = 0; i < m_starfield.size(); i++)
+	{
+		stars[i].x = m_starfield.x(i);
+		stars[i].y = m_starfield.y(i);
+		stars[i].size = m_starfield.starSize(i);
+	}
+}
+
+bool StudentWorld::restoreSnapshot(const vector<unsigned char>& in)
+{
+	SnapshotHeader h;
+	if (in.size() < sizeof(h))
+		return false;
+	memcpy(&h, &in[0], sizeof(h));
+	if (h.magic != SNAPSHOT_MAGIC || h.version != SNAPSHOT_VERSION ||
+		in.size() != sizeof(h) + (h.numActors + 1) * sizeof(ActorRecord) + h.numStars * sizeof(StarRecord))
+		return false;
+	if (h.level < getLevel() || h.lives == 0)		// the framework's level only ever goes up
+		return false;
+	if (h.archetypesHash != m_archetypes.hash())		// its aliens' kinds would name other rows, or rows that changed
+		return false;
+	ActorRecord r;
+	for (unsigned long long i = 1; i <= h.numActors; i++)
+	{
+		memcpy(&r, &in[sizeof(h) + i * sizeof(r)], sizeof(r));
+		if (r.kind < 0 || r.kind >= SPAWN_ALIEN + m_archetypes.size())
+			return false;
+	}
+
+	// a recording cannot replay a restore, so it stops here: what it holds so far still replays, and
+	// tearing the level down must not save it (cleanUp would) as if the game had gone on
+	m_inputLog = nullptr;
+	clearLevel();
+	while (getLevel() < h.level)
+		advanceToNextLevel();
+	computeLevelStats();		// before any alien is made
+	while (getLives() < h.lives)
+		incLives();
+	while (getLives() > h.lives)
+		decLives();
+	increaseScore(h.score - getScore());		// unsigned, so this wraps to the right score either way
+
+	m_alienShipsDestroyed = h.alienShipsDestroyed;
+	m_alienShipsToBeDestroyed = h.alienShipsToBeDestroyed;
+	m_maxAliensOnScreen = h.maxAliensOnScreen;
+	m_numAliensOnScreen = h.numAliensOnScreen;
+	m_goodiesCollected = h.goodiesCollected;
+	m_collisionMode = h.collisionMode;		// before any actor is added, since it decides who goes in the grids
+
+	// memcpy each record out rather than casting, since in's data need not be aligned for ActorRecord
+	const unsigned char* p = &in[sizeof(h)];
+	memcpy(&r, p, sizeof(r));
+	m_nachenBlaster = new NachenBlaster(this);
+	m_nachenBlaster->restore(r);
+	if (!r.alive)
+		m_nachenBlaster->setDead();
+
+	m_actors.reserve(h.numActors);
+	for (unsigned long long i = 0; i < h.numActors; i++)
+	{
+		p += sizeof(r);
+		memcpy(&r, p, sizeof(r));
+		Actor* a = createActor(r.kind, r.x, r.y);
+		a->restore(r);
+		m_nextSerial = r.serial;		// so hits keep being applied in the order they were when saved
+		addActor(a);
+		if (!r.alive)
+			a->setDead();
+	}
+	m_nextSerial = h.nextSerial;
+
+	StarRecord star;
+	for (unsigned long long i = 0; i < h.numStars; i++)
+	{
+		memcpy(&star, &in[sizeof(h) + (h.numActors + 1) * sizeof(r) + i * sizeof(star)], sizeof(star));
+		m_starfield.add(star.x, star.y, star.size);
+	}
+
+	m_rng.restore(h.rngState, h.rngStream);
+
+	refreshLineOfFire();
+	updateStatusText();
+	return true;
 }
 
 void StudentWorld::updateStatusText()
 {
 	// initialize game stats text string and set it
 	//m_gameStatText << "Lives: 3  Health: 100%  Score: 24530  Level: 3  Cabbages: 80%  Torpedoes: 4";
-	ostringstream oss;
-	oss.setf(ios::fixed);
-	oss.precision(0);
-	oss << "Lives: " << getLives();
-	oss << setw(10) << "Health: " << m_nachenBlaster->getHealthPercent() << "%  Score: " << getScore();
-	oss << setw(9) << "Level: " << getLevel();
-	oss << setw(11) << "Cabbages: " << m_nachenBlaster->getCabbagePercent() << "%";
-	oss << setw(13) << "Torpedoes: " << m_nachenBlaster->getNumTorpedoes();
-	setGameStatText(oss.str());
-}
\ No newline at end of file
+	// the framework keeps showing the last text it was given, so only pass it on when it changes. It takes the
+	// text as a std::string by value, and the line is longer than the small-string buffer, so each change costs
+	// one heap allocation that no caching on this side can avoid; tickbench counts those apart from the rest
+	if (m_statusText.update(getLives(), m_nachenBlaster->getHealthPercent(), getScore(), getLevel(),
+		m_nachenBlaster->getCabbagePercent(), m_nachenBlaster->getNumTorpedoes()))
+	{
+		setGameStatText(string(m_statusText.text(), m_statusText.length()));
+		m_statusTextsSent++;
+	}
+}
+
+const char* StudentWorld::statusText() const
+{
+	return m_statusText.text();
+}
+
+unsigned long StudentWorld::statusTextsSent() const
+{
+	return m_statusTextsSent;
+}
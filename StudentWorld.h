@@ -4,18 +4,72 @@
 #include "GameWorld.h"
 #include "GraphObject.h"
 #include "Actor.h"
+#include "SpatialGrid.h"
+#include "Random.h"
+#include "TickTrace.h"
+#include "ThreadPool.h"
+#include "StatusText.h"
+#include "Starfield.h"
+#include "AlienArchetypes.h"
+#include "LineOfFire.h"
+#include "SoundQueue.h"
+#include "RenderList.h"
 #include <string>
 #include <sstream>  // defines the type std::ostringstream
 #include <iomanip>  // defines the manipulator setw
-#include <list>
+#include <vector>
 using namespace std;
 
 class Actor;
 class NachenBlaster;
 class Alien;
+class InputLog;
 
 // Students:  Add code to this file, StudentWorld.cpp, Actor.h, and Actor.cpp
 
+// How collisions are found each tick
+const int COLLIDE_PER_ACTOR = 0;	// each actor checks itself in doSomething, before and after it moves (the original rules)
+const int COLLIDE_SWEEP = 1;		// opt-in: everyone moves first, then every overlapping pair is resolved exactly once
+
+// Actors that other actors spawn, for StudentWorld::spawnActor; snapshots use the whole list
+enum SpawnKind
+{
+	SPAWN_CABBAGE,
+	SPAWN_NB_TORPEDO,
+	SPAWN_TURNIP,
+	SPAWN_ALIEN_TORPEDO,
+	SPAWN_EXPLOSION,
+	SPAWN_REPAIR_GOODIE,
+	SPAWN_TORPEDO_GOODIE,
+	SPAWN_EXTRA_LIFE_GOODIE,
+	SPAWN_ALIEN,						// an alien of archetype i is SPAWN_ALIEN + i; the names below are the built-in table's
+	SPAWN_SMALLGON = SPAWN_ALIEN,
+	SPAWN_SMOREGON,
+	SPAWN_SNAGGLEGON
+};
+
+const int UPDATE_CHUNK_SIZE = 64;	// actors per task in the parallel update
+
+// When an actor spawned during a tick (a projectile, explosion or goodie) first acts
+const int SPAWN_ACTS_SAME_TICK = 0;	// later in the tick it was spawned in, after everyone already there (the original rules)
+const int SPAWN_ACTS_NEXT_TICK = 1;	// opt-in: from the next tick on; until then it only sits where it was spawned
+const int SPAWN_QUEUE_RESERVE = 64;	// spawns a tick can queue before the queue has to grow
+const int ACTOR_LIST_RESERVE = 256;	// actors a level can hold before m_actors has to grow
+const int COLLISION_SCRATCH_RESERVE = 64;	// candidates one collision check can gather before its scratch lists have to grow
+
+// Overrides for the level parameters init() normally works out on its own (used by the headless tools
+// to dial up actor density). A value of 0 keeps the normal one.
+struct WorldTuning
+{
+	WorldTuning();
+	int initialStars;				// normally 30
+	int maxAliensOnScreen;			// normally 4 + .5 * level
+	int alienShipsToBeDestroyed;	// normally 6 + 4 * level
+	int smallgonWeight;				// S1 in decideShipToAdd, normally 60 (the weight of archetype 0)
+	int smoregonWeight;				// S2, normally 20 + 5 * level (archetype 1)
+	int snagglegonWeight;			// S3, normally 5 + 10 * level (archetype 2)
+};
+
 class StudentWorld : public GameWorld
 {
 public:
@@ -27,27 +81,199 @@ public:
 
 	void recordAlienDestroyed();							// record that one more alien on current level has been destroyed
 	void addActor(Actor* a);								// add an actor to the world
+	ActorPool& actorPool();									// where actors living in this world are allocated from
+	void setSeed(uint64_t seed);							// restarts this world's random sequence; same seed and input, same game
+	void recordInput(InputLog* log);						// from now on log the seed, keys and per-tick state hashes (call before the first init(), after the settings); nullptr stops
+	bool readKey(int& value);								// GameWorld::getKey, recorded if recordInput is on
+	uint32_t stateHash() const;								// hash of everything that decides how the game goes on
+	uint32_t alienArchetypesHash() const;					// AlienArchetypes::hash of the alien table this world plays with
+	int randInt(int min, int max);							// all gameplay randomness goes through here, never the global randInt
+	void setTuning(const WorldTuning& tuning);				// takes effect at the next init()
+	void setCollisionMode(int mode);						// COLLIDE_PER_ACTOR (default) or COLLIDE_SWEEP; takes effect at the next init()
+	void setUpdateThreads(int n);							// 0 (default) updates actors in order; n >= 1 uses the parallel update on n threads (COLLIDE_SWEEP only)
+	void setSpawnTiming(int timing);						// SPAWN_ACTS_SAME_TICK (default) or SPAWN_ACTS_NEXT_TICK; takes effect at the next tick
+	void spawnActor(int kind, double x, double y);			// creates a SPAWN_* actor and queues it to join the world, or queues the spawn during a parallel update
+	void emitSound(int soundID);							// queues a sound for the end of this move() (during a parallel update, via the chunk's commands)
+	void setSoundVoices(int voices);						// most times one sound plays per tick, SOUND_VOICES_PER_ID by default; 0 plays every request
+	void setPlaySounds(bool play);							// false drains the sound queue without playing it, for headless runs nobody listens to
+	void setBuildRenderList(bool build);					// whether move() ends by building the render list; off by default, since the framework draws GraphObjects itself
+	RenderList& renderList();								// the sprites on screen after the last move(), sorted for batched drawing
+	int numActors() const;									// number of actors in the world, not counting the NachenBlaster or the stars
+	unsigned long goodiesCollected() const;					// goodies the NachenBlaster has picked up since the world was created
+	const char* statusText() const;							// the status line as last given to setGameStatText
+	unsigned long statusTextsSent() const;					// setGameStatText calls since the world was created; each builds one std::string
+	void saveSnapshot(vector<unsigned char>& out) const;	// replaces out with a binary image of the level in progress
+	bool restoreSnapshot(const vector<unsigned char>& in);	// replaces the level in progress; false (world untouched) if in is not a snapshot this world can restore,
+															// including one saved with a different alien table. Stops any recording (see recordInput) at the restore.
+															// Settings for later levels (tuning, setCollisionMode, setUpdateThreads, setSpawnTiming) are not part of a snapshot.
 	void checkCollision(Actor* a);							// given Actor a, method will check to see if any actors in StudentWorld have collided with a
+	void actorMoved(Actor* a);								// called by Actor::moveTo so the actor store and collision grid follow the actor
+	void actorDied(Actor* a);								// called by Actor::setDead so the actor store sees the death
+#ifdef INSTRUMENT_TICKS
+	TickTrace& tickTrace();									// per-tick counters and phase times recorded by move()
+#endif
 	bool playerInLineOfFire(const Actor* a) const;			// Is the player in the line of fire of a, which might cause a to attack?
+	int aliensInLineOfFire(vector<Actor*>& out);		// replaces out with every alien that has the player in its line of fire (as of the player's last move); returns how many
+	const AlienLevelStats& alienLevelStats(int archetype) const;	// an archetype's hit points, firing odds and spawn weight on this level
 	void increasePlayerHP();								// tells the Nachenblaster to increase hit points by 10
 	void increaseTorpedoes();								// tells NB to increase Torpedoes by 5
 
 private:
+	friend class WorldBench;		// tools/microbench.cpp times some of the private steps directly
+
 	// private methods used only by StudentWorld
+	int tick();						// the body of move(), which adds the recording on top
 	void updateStatusText();		// updates the status text at top of screen
-	int decideShipToAdd();			// function to decide which ship to add
+	void clearLevel();				// what cleanUp does apart from saving the NACHENBLASTER_RECORD recording
+	int decideShipToAdd();			// function to decide which ship to add; returns an archetype
+	int shipWeight(int archetype) const;	// how likely decideShipToAdd is to pick it on this level
+	void computeLevelStats();		// fills m_levelStats for the current level and tuning
+	void refreshLineOfFire();		// after the NachenBlaster moves
+	void flushSounds();				// plays (or drops) the tick's queued sounds
+	void buildRenderList();			// publishes everything on screen to m_renderList
+	double starSize();				// random size for a new star
 	void deleteDeadActors();		// delete dead actors
-	double euclidean_dist(double x1, double y1, double x2, double y2) const;		// gives Euclidean distance between 2 objects
+	void registerActor(Actor* a);	// gives a its serial and its place in the store and grid
+	bool commitSpawns();			// appends the queued spawns to m_actors in one go; false if there were none
 	bool isCollision(const Actor* a, const Actor* p) const;								// checks if Actor a and Actor p have collided
+	bool hasGrid(int category) const;					// only aliens and projectiles can be hit by a moving actor, so only they get a grid (and only in COLLIDE_PER_ACTOR)
+	void findHits(const Actor* a, int categoryMask);	// fills m_hits with the actors in the masked categories that collide with a, in the order they were added
+
+	// an actor found to collide with the one being checked
+	struct Hit
+	{
+		unsigned int serial;
+		ActorHandle handle;
+	};
+	static bool earlierSerial(const Hit& a, const Hit& b);
+
+	// COLLIDE_SWEEP: one collision phase per tick, sort-and-sweep along x
+	void resolveCollisions();
+	void resolvePair(Actor* a, int categoryA, Actor* b, int categoryB);
+	static int targetsOf(int category);					// mask of the categories an actor of this category can collide with
+
+	struct SweepEntry
+	{
+		double minX;		// x extent of the actor's collision reach, .75 * radius either side
+		double maxX;
+		double x;
+		double y;
+		double radius;
+		unsigned int serial;
+		int category;		// CATEGORY_* or SWEEP_NACHENBLASTER
+		Actor* actor;
+	};
+	static bool sweepsBefore(const SweepEntry& a, const SweepEntry& b);
+
+	// parallel update: actors act on the pool's threads, drawing randomness from their own stream and
+	// queueing spawns and sounds per chunk; the queues are applied in chunk order once every chunk is done
+	enum { COMMAND_SOUND = -1, COMMAND_ALIEN_LEFT = -2 };
+	struct TickCommand
+	{
+		int kind;			// SPAWN_* for a spawn, or a COMMAND_*
+		int soundID;
+		double x;
+		double y;
+	};
+	class ActorUpdate : public ParallelTask
+	{
+	public:
+		ActorUpdate(StudentWorld* world, size_t begin, size_t end, uint64_t tickSeed);
+		virtual void runTask(int chunk);
+	private:
+		StudentWorld* m_world;
+		size_t m_begin;
+		size_t m_end;
+		uint64_t m_tickSeed;
+	};
+	struct UpdateWorker						// what a thread is doing for the parallel update, if anything
+	{
+		const StudentWorld* world;
+		Rng rng;
+		vector<TickCommand>* commands;
+	};
+	static thread_local UpdateWorker* s_worker;		// set while this thread runs a chunk of some world's parallel update
+	static UpdateWorker* currentWorker(const StudentWorld* world);
+	void updateActorsInParallel();
+	Actor* createActor(int kind, double x, double y);
+
+	// snapshot layout: a SnapshotHeader, the NachenBlaster's ActorRecord, one ActorRecord per actor in m_actors, then
+	// one StarRecord per star, all in native byte order and padding, so a snapshot is only meant for builds of the
+	// same code on the same platform
+	struct SnapshotHeader
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int level;
+		unsigned int lives;
+		unsigned int score;
+		int collisionMode;
+		uint32_t archetypesHash;	// the alien table's, since aliens are saved as rows of it
+		uint64_t rngState;
+		uint64_t rngStream;
+		unsigned int nextSerial;
+		int alienShipsDestroyed;
+		int alienShipsToBeDestroyed;
+		int maxAliensOnScreen;
+		int numAliensOnScreen;
+		unsigned long long goodiesCollected;
+		unsigned long long numActors;
+		unsigned long long numStars;
+	};
+	struct StarRecord
+	{
+		double x;
+		double y;
+		double size;
+	};
 
 	// private member variables
-	list<Actor*> m_actors;			// holds all live actors in current world
+	ActorPool m_pool;				// backs every actor in m_actors; must outlive them
+	vector<Actor*> m_actors;		// holds all live actors in current world, in the order they act
+	vector<Actor*> m_spawned;		// spawned this tick and already collidable, but not yet in m_actors
+	Starfield m_starfield;			// the background stars, which are not actors
+	LineOfFire m_lineOfFire;		// where the NachenBlaster can be shot from this tick
 	NachenBlaster* m_nachenBlaster;			// pointer to the NachenBlaster object
+	ActorStore m_store;				// positions, radii, alive flags and kinds of every actor in m_actors, by category
+	SpatialGrid m_grids[NUM_CATEGORIES];	// broad phase for checkCollision, one per category that hasGrid
+	vector<ActorHandle> m_nearby;	// scratch lists reused by checkCollision so queries do not allocate
+	vector<Coord> m_nearbyX;		// positions and radii of m_nearby, packed for the collision kernel
+	vector<Coord> m_nearbyY;
+	vector<Coord> m_nearbyRadius;
+	vector<int> m_hitIndices;
+	vector<Hit> m_hits;
+	vector<SweepEntry> m_sweep;		// scratch list reused by resolveCollisions
+	vector<void*> m_deadSlots;		// scratch list reused by deleteDeadActors
+	unsigned int m_nextSerial;		// serial number given to the next actor added
+	int m_collisionMode;			// mode of the level in progress
+	int m_nextCollisionMode;		// mode the next init() switches to
+	int m_updateThreads;			// 0 for the in-order update
+	int m_spawnTiming;
+	ThreadPool m_threads;
+	SoundQueue m_sounds;			// sounds asked for since the last flushSounds
+	bool m_playSounds;
+	RenderList m_renderList;
+	bool m_buildRenderList;
+	vector<vector<TickCommand> > m_chunkCommands;	// one queue per chunk of the parallel update, reused every tick
+	WorldTuning m_tuning;
+	AlienArchetypes m_archetypes;	// every alien points at its row, so the table is only ever replaced by the constructor
+	vector<AlienLevelStats> m_levelStats;	// one per archetype, for the level in progress; aliens point into it, so it is only rebuilt with no aliens around
+	Rng m_rng;
+#ifdef INSTRUMENT_TICKS
+	TickTrace m_trace;
+#endif
 
 	int m_alienShipsDestroyed;		// int to hold the number of ships that have been destroyed
 	int m_alienShipsToBeDestroyed;	// total number of ships that need to be destroyed to advance
 	int m_maxAliensOnScreen;			// number of max aliens that can be on screen at one time
 	int m_numAliensOnScreen;			// number of aliens on screen at current time
+	int m_aliensLeaving;			// aliens killed or flown off screen this tick; they count as on screen until they are deleted
+	unsigned long m_goodiesCollected;
+	StatusText m_statusText;		// last text given to setGameStatText
+	unsigned long m_statusTextsSent;
+	uint64_t m_seed;				// last seed given to m_rng
+	InputLog* m_inputLog;			// nullptr when not recording
+	InputLog* m_ownedInputLog;		// recording started by NACHENBLASTER_RECORD, saved by every cleanUp
 };
 
 #endif // STUDENTWORLD_H_
@@ -0,0 +1,90 @@
+#include "ThreadPool.h"
+using namespace std;
+
+ThreadPool::ThreadPool()
+	: m_task(nullptr), m_numTasks(0), m_nextTask(0), m_busyWorkers(0), m_batch(0), m_stopping(false)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+int ThreadPool::workers() const
+{
+	return m_threads.size();
+}
+
+void ThreadPool::setWorkers(int n)
+{
+	stop();
+	m_stopping = false;
+	for (int i = 0; i < n; i++)
+		m_threads.push_back(thread(&ThreadPool::workerLoop, this, m_batch));
+}
+
+void ThreadPool::stop()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+	for (vector<thread>::iterator t = m_threads.begin(); t != m_threads.end(); t++)
+		t->join();
+	m_threads.clear();
+}
+
+void ThreadPool::run(ParallelTask& task, int numTasks)
+{
+	if (m_threads.empty())
+	{
+		for (int i = 0; i < numTasks; i++)
+			task.runTask(i);
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_task = &task;
+		m_numTasks = numTasks;
+		m_nextTask = 0;
+		m_busyWorkers = m_threads.size();
+		m_batch++;
+	}
+	m_wake.notify_all();
+
+	claimTasks();
+
+	unique_lock<mutex> lock(m_mutex);
+	while (m_busyWorkers > 0)
+		m_done.wait(lock);
+	m_task = nullptr;
+}
+
+void ThreadPool::claimTasks()
+{
+	for (int i = m_nextTask++; i < m_numTasks; i = m_nextTask++)
+		m_task->runTask(i);
+}
+
+void ThreadPool::workerLoop(unsigned int seenBatch)
+{
+	unique_lock<mutex> lock(m_mutex);
+	for (;;)
+	{
+		while (!m_stopping && m_batch == seenBatch)
+			m_wake.wait(lock);
+		if (m_stopping)
+			return;
+		seenBatch = m_batch;
+
+		lock.unlock();
+		claimTasks();
+		lock.lock();
+
+		if (--m_busyWorkers == 0)
+			m_done.notify_one();
+	}
+}
@@ -0,0 +1,57 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// One batch of independent tasks, numbered 0 to n - 1
+class ParallelTask
+{
+public:
+	virtual ~ParallelTask() {}
+	virtual void runTask(int i) = 0;		// may run on any thread, in any order
+};
+
+// Persistent worker threads for StudentWorld's parallel update. run() hands out a batch of tasks and
+// returns once all of them are done; the calling thread works on the batch too. Idle threads claim the
+// next unstarted task from a shared counter, so a thread that finishes early takes work the others have
+// not reached yet.
+class ThreadPool
+{
+public:
+	// Constructor and destructor
+	ThreadPool();
+	~ThreadPool();
+
+	// Accessors
+	int workers() const;					// threads besides the caller of run()
+
+	// Mutators
+	void setWorkers(int n);					// stops the current workers and starts n new ones
+	void run(ParallelTask& task, int numTasks);
+
+private:
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+
+	void workerLoop(unsigned int seenBatch);	// seenBatch: the last batch posted before the worker started
+	void claimTasks();						// runs unclaimed tasks of the current batch until there are none
+	void stop();
+
+	vector<thread> m_threads;
+	mutex m_mutex;
+	condition_variable m_wake;				// a new batch was posted, or the pool is stopping
+	condition_variable m_done;				// the last worker left the current batch
+	ParallelTask* m_task;
+	int m_numTasks;
+	atomic<int> m_nextTask;
+	int m_busyWorkers;						// workers still inside the current batch
+	unsigned int m_batch;					// bumped for every batch so workers can tell a new one from a spurious wakeup
+	bool m_stopping;
+};
+
+#endif // THREADPOOL_H_
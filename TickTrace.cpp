@@ -0,0 +1,155 @@
+#include "TickTrace.h"
+
+#ifdef INSTRUMENT_TICKS
+
+#include <cstdio>
+using namespace std;
+
+static const char* const PHASE_NAMES[NUM_PHASES] = { "player", "actors", "collisions", "spawn", "cleanup", "status", "end_of_tick" };
+static const char* const CATEGORY_NAMES[NUM_CATEGORIES] = { "aliens", "nb_projectiles", "alien_projectiles", "goodies", "explosions" };
+
+TickTrace::TickTrace()
+	: m_start(chrono::steady_clock::now()), m_oldest(0), m_newest(0), m_nextTick(0), m_inTick(false), m_betweenTicks(), m_phase(-1), m_phaseStartNs(0)
+{
+}
+
+size_t TickTrace::numRecords() const
+{
+	return m_records.size();
+}
+
+const TickRecord& TickTrace::record(size_t i) const
+{
+	return m_records[(m_oldest + i) % m_records.size()];
+}
+
+long long TickTrace::now() const
+{
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_start).count();
+}
+
+void TickTrace::beginTick()
+{
+	TickRecord r = TickRecord();
+	r.tick = m_nextTick++;
+	r.startNs = now();
+	if (m_records.size() < static_cast<size_t>(TICK_TRACE_CAPACITY))
+	{
+		m_newest = m_records.size();
+		m_records.push_back(r);
+	}
+	else
+	{
+		m_newest = m_oldest;
+		m_records[m_newest] = r;
+		m_oldest = (m_oldest + 1) % m_records.size();
+	}
+	m_inTick = true;
+	m_phase = -1;
+}
+
+void TickTrace::countActors(const ActorStore& store, int stars)
+{
+	current().stars = stars;
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+		current().actors[i] = store.size(i);
+}
+
+void TickTrace::enterPhase(int phase)
+{
+	long long t = now();
+	if (m_phase >= 0)
+		current().phaseNs[m_phase] += t - m_phaseStartNs;
+	m_phase = phase;
+	m_phaseStartNs = t;
+}
+
+void TickTrace::endTick()
+{
+	enterPhase(-1);
+	m_inTick = false;
+}
+
+TickRecord& TickTrace::current()
+{
+	return m_inTick ? m_records[m_newest] : m_betweenTicks;
+}
+
+void TickTrace::clear()
+{
+	m_records.clear();
+	m_oldest = 0;
+	m_newest = 0;
+}
+
+bool TickTrace::writeCsv(const string& path) const
+{
+	FILE* f = fopen(path.c_str(), "w");
+	if (f == nullptr)
+		return false;
+
+	fprintf(f, "tick,start_ns,stars");
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+		fprintf(f, ",%s", CATEGORY_NAMES[i]);
+	fprintf(f, ",collision_checks,pairs_tested,hits,actors_added,actors_deleted");
+	for (int i = 0; i < NUM_PHASES; i++)
+		fprintf(f, ",%s_ns", PHASE_NAMES[i]);
+	fprintf(f, "\n");
+
+	for (size_t i = 0; i < m_records.size(); i++)
+	{
+		const TickRecord* r = &record(i);
+		fprintf(f, "%u,%lld,%d", r->tick, r->startNs, r->stars);
+		for (int i = 0; i < NUM_CATEGORIES; i++)
+			fprintf(f, ",%d", r->actors[i]);
+		fprintf(f, ",%d,%d,%d,%d,%d", r->collisionChecks, r->pairsTested, r->hits, r->actorsAdded, r->actorsDeleted);
+		for (int i = 0; i < NUM_PHASES; i++)
+			fprintf(f, ",%lld", r->phaseNs[i]);
+		fprintf(f, "\n");
+	}
+	return fclose(f) == 0;
+}
+
+bool TickTrace::writeChromeTrace(const string& path) const
+{
+	FILE* f = fopen(path.c_str(), "w");
+	if (f == nullptr)
+		return false;
+
+	// timestamps are in microseconds; each tick is one complete event carrying its counters, with its
+	// phases laid end to end inside it, plus a counter track for the actor counts
+	fprintf(f, "{\"traceEvents\":[\n");
+	const char* separator = "";
+	for (size_t i = 0; i < m_records.size(); i++)
+	{
+		const TickRecord* r = &record(i);
+		long long tickNs = 0;
+		for (int i = 0; i < NUM_PHASES; i++)
+			tickNs += r->phaseNs[i];
+
+		fprintf(f, "%s{\"name\":\"tick\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"tick\":%u,"
+			"\"collision_checks\":%d,\"pairs_tested\":%d,\"hits\":%d,\"actors_added\":%d,\"actors_deleted\":%d}}",
+			separator, r->startNs / 1000.0, tickNs / 1000.0, r->tick,
+			r->collisionChecks, r->pairsTested, r->hits, r->actorsAdded, r->actorsDeleted);
+		separator = ",\n";
+
+		long long phaseStartNs = r->startNs;
+		for (int i = 0; i < NUM_PHASES; i++)
+		{
+			if (r->phaseNs[i] == 0)
+				continue;
+			fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+				PHASE_NAMES[i], phaseStartNs / 1000.0, r->phaseNs[i] / 1000.0);
+			phaseStartNs += r->phaseNs[i];
+		}
+
+		fprintf(f, ",\n{\"name\":\"actors\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"stars\":%d", r->startNs / 1000.0, r->stars);
+		for (int i = 0; i < NUM_CATEGORIES; i++)
+			fprintf(f, ",\"%s\":%d", CATEGORY_NAMES[i], r->actors[i]);
+		fprintf(f, "}}");
+	}
+	fprintf(f, "\n]}\n");
+	return fclose(f) == 0;
+}
+
+#endif // INSTRUMENT_TICKS
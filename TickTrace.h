@@ -0,0 +1,106 @@
+#ifndef TICKTRACE_H_
+#define TICKTRACE_H_
+
+// Per-tick instrumentation for StudentWorld::move. Build with -DINSTRUMENT_TICKS to turn it on; without it
+// the TRACE_* macros expand to nothing, StudentWorld has no trace member and this header declares nothing else.
+
+#ifdef INSTRUMENT_TICKS
+
+#include "ActorStore.h"
+#include <chrono>
+#include <string>
+#include <vector>
+using namespace std;
+
+const int TICK_TRACE_CAPACITY = 65536;		// ticks kept; after that each new tick replaces the oldest
+
+// Phases of a tick, in the order move() runs them
+enum TickPhase
+{
+	PHASE_PLAYER,		// NachenBlaster's doSomething
+	PHASE_ACTORS,		// every other actor's doSomething, including per-actor collision checks
+	PHASE_COLLISIONS,	// COLLIDE_SWEEP's collision phase
+	PHASE_SPAWN,		// new stars and aliens
+	PHASE_CLEANUP,		// deleteDeadActors
+	PHASE_STATUS,		// updateStatusText
+	PHASE_END_OF_TICK,	// commitSpawns, flushSounds, buildRenderList and the recording's state hash
+	NUM_PHASES
+};
+
+// Everything recorded about one tick
+struct TickRecord
+{
+	unsigned int tick;
+	long long startNs;					// since the trace was started
+	int stars;							// stars in the starfield when the tick began
+	int actors[NUM_CATEGORIES];			// actors in each store category when the tick began
+	int collisionChecks;				// checkCollision calls
+	int pairsTested;					// actor pairs handed to the narrow phase
+	int hits;							// collisions applied (a pair involving an actor already dead this tick is not one)
+	int actorsAdded;					// addActor calls (one pool allocation each)
+	int actorsDeleted;					// actors freed by deleteDeadActors
+	long long phaseNs[NUM_PHASES];
+};
+
+class TickTrace
+{
+public:
+	// Constructor
+	TickTrace();
+
+	// Accessors
+	size_t numRecords() const;								// at most TICK_TRACE_CAPACITY
+	const TickRecord& record(size_t i) const;				// i-th oldest of the ticks kept
+	bool writeCsv(const string& path) const;				// one row per tick
+	bool writeChromeTrace(const string& path) const;		// trace-event JSON for chrome://tracing or Perfetto
+
+	// Mutators
+	void beginTick();
+	void countActors(const ActorStore& store, int stars);
+	void enterPhase(int phase);							// ends the phase in progress, if any
+	void endTick();
+	TickRecord& current();									// the tick in progress; counts made between ticks (e.g. by init()) are dropped
+	void clear();											// forget every record; tick numbers carry on
+
+private:
+	long long now() const;
+
+	chrono::steady_clock::time_point m_start;
+	vector<TickRecord> m_records;		// ring of the last TICK_TRACE_CAPACITY ticks, filled before it wraps
+	size_t m_oldest;					// index of the oldest record
+	size_t m_newest;					// index of the tick in progress, or of the last one
+	unsigned int m_nextTick;
+	bool m_inTick;
+	TickRecord m_betweenTicks;			// soaks up counts made outside move()
+	int m_phase;						// phase in progress, -1 if none
+	long long m_phaseStartNs;
+};
+
+// Ends the tick when move() returns, whichever return it takes
+class TickScope
+{
+public:
+	TickScope(TickTrace& trace) : m_trace(trace) { m_trace.beginTick(); }
+	~TickScope() { m_trace.endTick(); }
+
+private:
+	TickScope(const TickScope&);
+	TickScope& operator=(const TickScope&);
+	TickTrace& m_trace;
+};
+
+#define TRACE_TICK(trace) TickScope traceTickScope_(trace)
+#define TRACE_ACTOR_COUNTS(trace, store, stars) (trace).countActors(store, stars)
+#define TRACE_PHASE(trace, phase) (trace).enterPhase(phase)
+#define TRACE_COUNT(trace, field, n) ((trace).current().field += (n))
+
+#else
+
+#define TRACE_TICK(trace)
+#define TRACE_ACTOR_COUNTS(trace, store, stars)
+#define TRACE_PHASE(trace, phase)
+#define TRACE_COUNT(trace, field, n)
+
+#endif // INSTRUMENT_TICKS
+
+#endif // TICKTRACE_H_
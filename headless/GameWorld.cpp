@@ -0,0 +1,46 @@
+// Headless replacement for the framework's GameWorld.cpp: no window, no audio, no keyboard.
+#include "GameWorld.h"
+#include "Headless.h"
+#include <string>
+using namespace std;
+
+static thread_local HeadlessContext* s_context = nullptr;
+
+HeadlessContext::HeadlessContext()
+	: input(nullptr), keepStatusText(false), soundsPlayed(0)
+{
+	for (int i = 0; i < MAX_HEADLESS_SOUND_ID; i++)
+		soundCounts[i] = 0;
+}
+
+void bindHeadlessContext(HeadlessContext* context)
+{
+	s_context = context;
+}
+
+HeadlessContext* boundHeadlessContext()
+{
+	return s_context;
+}
+
+void GameWorld::setGameStatText(string text)
+{
+	if (s_context != nullptr && s_context->keepStatusText)
+		s_context->statusText = text;
+}
+
+bool GameWorld::getKey(int& value)
+{
+	if (s_context == nullptr || s_context->input == nullptr)
+		return false;
+	return s_context->input->getKey(value);
+}
+
+void GameWorld::playSound(int soundID)
+{
+	if (s_context == nullptr)
+		return;
+	s_context->soundsPlayed++;
+	if (soundID >= 0 && soundID < MAX_HEADLESS_SOUND_ID)
+		s_context->soundCounts[soundID]++;
+}
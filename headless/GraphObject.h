@@ -0,0 +1,54 @@
+#ifndef GRAPHOBJ_H_
+#define GRAPHOBJ_H_
+
+// Headless replacement for the framework's GraphObject.h. Same interface as far as the game uses it,
+// but objects are not registered with the sprite layers, so nothing is drawn and constructing or
+// destroying one never touches shared state (worlds can run on several threads at once).
+
+#include "GameConstants.h"
+
+class GraphObject
+{
+public:
+	static const int kRadiusPerUnit = 8;
+
+	GraphObject(int imageID, double startX, double startY, int startDirection = 0, double size = 1.0, int depth = 0)
+		: m_imageID(imageID), m_x(startX), m_y(startY), m_direction(startDirection), m_size(size), m_depth(depth)
+	{
+		if (m_size <= 0)
+			m_size = 1;
+	}
+
+	virtual ~GraphObject() {
+	}
+
+	double getX() const { return m_x; }
+	double getY() const { return m_y; }
+	virtual void moveTo(double x, double y) { m_x = x; m_y = y; }
+
+	int getDirection() const { return m_direction; }
+	void setDirection(int d)
+	{
+		while (d < 0)
+			d += 360;
+		m_direction = d % 360;
+	}
+
+	double getSize() const { return m_size; }
+	void setSize(double size) { m_size = size; }
+	double getRadius() const { return kRadiusPerUnit * m_size; }
+
+private:
+	// prevent copying or assigning GraphObjects
+	GraphObject(const GraphObject&);
+	GraphObject& operator=(const GraphObject&);
+
+	int m_imageID;
+	double m_x;
+	double m_y;
+	int m_direction;
+	double m_size;
+	int m_depth;
+};
+
+#endif // GRAPHOBJ_H_
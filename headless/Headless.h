@@ -0,0 +1,38 @@
+#ifndef HEADLESS_H_
+#define HEADLESS_H_
+
+#include <string>
+
+// Headless stand-ins for the framework's keyboard, sound and status line. Link headless/GameWorld.cpp
+// instead of the framework's GameWorld.cpp/GameController.cpp, and put headless/ ahead of the framework
+// on the include path so headless/GraphObject.h (which draws nothing) replaces the real one.
+//
+// GameWorld::getKey, playSound and setGameStatText use the context bound to the calling thread, so
+// several worlds can run headless side by side as long as each thread binds its world's context.
+
+// Where a headless world gets its key presses from
+class InputSource
+{
+public:
+	virtual ~InputSource() {
+	}
+	virtual bool getKey(int& value) = 0;		// same contract as GameWorld::getKey
+};
+
+const int MAX_HEADLESS_SOUND_ID = 64;			// sound IDs at or above this are only counted in soundsPlayed
+
+struct HeadlessContext
+{
+	HeadlessContext();
+
+	InputSource* input;				// nullptr means no key is ever pressed
+	bool keepStatusText;			// copy the status text into statusText (off by default, it costs a string copy)
+	std::string statusText;
+	unsigned long soundsPlayed;		// total playSound calls
+	unsigned long soundCounts[MAX_HEADLESS_SOUND_ID];
+};
+
+void bindHeadlessContext(HeadlessContext* context);		// nullptr unbinds; an unbound thread gets no input and no output
+HeadlessContext* boundHeadlessContext();
+
+#endif // HEADLESS_H_
@@ -0,0 +1,25 @@
+#include "Pilot.h"
+#include "GameConstants.h"
+
+RandomPilot::RandomPilot(uint64_t seed)
+	: m_rng(seed)
+{
+}
+
+bool RandomPilot::getKey(int& value)
+{
+	int roll = m_rng.randInt(0, 19);
+	if (roll < 8)
+		value = KEY_PRESS_SPACE;
+	else if (roll < 10)
+		value = KEY_PRESS_TAB;
+	else if (roll < 14)
+		value = KEY_PRESS_UP;
+	else if (roll < 18)
+		value = KEY_PRESS_DOWN;
+	else if (roll < 19)
+		value = KEY_PRESS_RIGHT;
+	else
+		return false;
+	return true;
+}
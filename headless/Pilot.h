@@ -0,0 +1,19 @@
+#ifndef PILOT_H_
+#define PILOT_H_
+
+#include "Headless.h"
+#include "Random.h"
+
+// Scripted stand-in for a player: fires cabbages most ticks, sometimes a torpedo, and weaves up and
+// down, so headless runs exercise projectiles, collisions and goodie pickups. Reproducible for a seed.
+class RandomPilot : public InputSource
+{
+public:
+	RandomPilot(uint64_t seed);
+	virtual bool getKey(int& value);
+
+private:
+	Rng m_rng;
+};
+
+#endif // PILOT_H_
@@ -0,0 +1,251 @@
+// batchrun: plays many independent headless games across all cores and reports per-level outcomes.
+//
+//   batchrun [--games G] [--threads T] [--seed S] [--levels L] [--lives N] [--max-ticks M]
+//            [--ships K] [--aliens A] [--s1 W] [--s2 W] [--s3 W] [--sweep 1]
+//
+// Each game is a StudentWorld with its own RNG and actor pool, played by a RandomPilot from level 1
+// until it runs out of lives (N, default 3), finishes level L (default 5) or has run M ticks (default
+// 200000). Game i is seeded from S and i only, so the report does not depend on --threads. --ships,
+// --aliens and --s1/--s2/--s3 override the level parameters and decideShipToAdd's weights (see
+// WorldTuning); --sweep 1 uses COLLIDE_SWEEP.
+#include "StudentWorld.h"
+#include "Headless.h"
+#include "Pilot.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+using namespace std;
+
+struct Options
+{
+	long games;
+	int threads;
+	unsigned int seed;
+	int levels;
+	int lives;
+	long maxTicks;
+	int collisionMode;
+	WorldTuning tuning;
+};
+
+// What happened on one level, summed over every attempt at it
+struct LevelOutcome
+{
+	LevelOutcome();
+	long games;					// games that reached the level
+	long completions;
+	long long completionTicks;	// ticks from reaching the level to finishing it, deaths included
+	long deaths;
+	long long score;			// points earned on the level
+	long goodies;				// goodies picked up on the level
+};
+
+LevelOutcome::LevelOutcome()
+	: games(0), completions(0), completionTicks(0), deaths(0), score(0), goodies(0)
+{
+}
+
+struct GameResult
+{
+	vector<LevelOutcome> levels;	// index 0 is level 1
+	long long ticks;
+};
+
+static void usage()
+{
+	fprintf(stderr, "usage: batchrun [--games G] [--threads T] [--seed S] [--levels L] [--lives N] [--max-ticks M]\n"
+		"                [--ships K] [--aliens A] [--s1 W] [--s2 W] [--s3 W] [--sweep 1]\n");
+	exit(2);
+}
+
+static Options parseOptions(int argc, char* argv[])
+{
+	Options o;
+	o.games = 1000;
+	o.threads = max(1u, thread::hardware_concurrency());
+	o.seed = 1;
+	o.levels = 5;
+	o.lives = 3;
+	o.maxTicks = 200000;
+	o.collisionMode = COLLIDE_PER_ACTOR;
+	for (int i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+			usage();
+		long v = atol(argv[i + 1]);
+		if (strcmp(argv[i], "--games") == 0)
+			o.games = v;
+		else if (strcmp(argv[i], "--threads") == 0)
+			o.threads = v;
+		else if (strcmp(argv[i], "--seed") == 0)
+			o.seed = v;
+		else if (strcmp(argv[i], "--levels") == 0)
+			o.levels = v;
+		else if (strcmp(argv[i], "--lives") == 0)
+			o.lives = v;
+		else if (strcmp(argv[i], "--max-ticks") == 0)
+			o.maxTicks = v;
+		else if (strcmp(argv[i], "--ships") == 0)
+			o.tuning.alienShipsToBeDestroyed = v;
+		else if (strcmp(argv[i], "--aliens") == 0)
+			o.tuning.maxAliensOnScreen = v;
+		else if (strcmp(argv[i], "--s1") == 0)
+			o.tuning.smallgonWeight = v;
+		else if (strcmp(argv[i], "--s2") == 0)
+			o.tuning.smoregonWeight = v;
+		else if (strcmp(argv[i], "--s3") == 0)
+			o.tuning.snagglegonWeight = v;
+		else if (strcmp(argv[i], "--sweep") == 0)
+			o.collisionMode = v ? COLLIDE_SWEEP : COLLIDE_PER_ACTOR;
+		else
+			usage();
+		i++;
+	}
+	if (o.games < 1 || o.threads < 1 || o.levels < 1 || o.lives < 1 || o.maxTicks < 1)
+		usage();
+	return o;
+}
+
+// splitmix64, to turn (seed, game) into well separated world and pilot seeds
+static uint64_t mix(uint64_t x)
+{
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+static void playGame(const Options& o, long game, GameResult& result)
+{
+	result.levels.assign(o.levels, LevelOutcome());
+	result.ticks = 0;
+
+	uint64_t gameSeed = mix(o.seed ^ mix(game));
+	RandomPilot pilot(mix(gameSeed));
+	HeadlessContext context;
+	context.input = &pilot;
+	bindHeadlessContext(&context);
+
+	StudentWorld world("");
+	world.setSeed(gameSeed);
+	world.setTuning(o.tuning);
+	world.setCollisionMode(o.collisionMode);
+	world.setPlaySounds(false);		// nobody is listening, and the report does not count sounds
+	while (world.getLives() < static_cast<unsigned int>(o.lives))
+		world.incLives();
+	while (world.getLives() > static_cast<unsigned int>(o.lives))
+		world.decLives();
+	world.advanceToNextLevel();
+	world.init();
+
+	LevelOutcome* level = &result.levels[0];
+	level->games++;
+	long long levelTicks = 0;
+	unsigned int levelScore = world.getScore();
+	unsigned long levelGoodies = world.goodiesCollected();
+
+	while (result.ticks < o.maxTicks)
+	{
+		int status = world.move();
+		result.ticks++;
+		levelTicks++;
+		if (status == GWSTATUS_CONTINUE_GAME)
+			continue;
+
+		level->score += world.getScore() - levelScore;
+		level->goodies += world.goodiesCollected() - levelGoodies;
+		levelScore = world.getScore();
+		levelGoodies = world.goodiesCollected();
+		world.cleanUp();
+
+		if (status == GWSTATUS_PLAYER_DIED)
+		{
+			level->deaths++;
+			if (world.getLives() == 0)
+				break;
+		}
+		else
+		{
+			level->completions++;
+			level->completionTicks += levelTicks;
+			if (static_cast<int>(world.getLevel()) >= o.levels)
+				break;
+			world.advanceToNextLevel();
+			level = &result.levels[world.getLevel() - 1];
+			level->games++;
+			levelTicks = 0;
+		}
+		world.init();
+	}
+	// a game cut off by --max-ticks mid-level still scored on that level (after a break above this adds nothing)
+	level->score += world.getScore() - levelScore;
+	level->goodies += world.goodiesCollected() - levelGoodies;
+
+	bindHeadlessContext(nullptr);
+}
+
+// one task per game; results land in the game's own slot, so threads never share anything
+class GameBatch : public ParallelTask
+{
+public:
+	GameBatch(const Options& o, vector<GameResult>& results) : m_options(o), m_results(results) {}
+	virtual void runTask(int i) { playGame(m_options, i, m_results[i]); }
+
+private:
+	const Options& m_options;
+	vector<GameResult>& m_results;
+};
+
+int main(int argc, char* argv[])
+{
+	Options o = parseOptions(argc, argv);
+
+	vector<GameResult> results(o.games);
+	ThreadPool pool;
+	pool.setWorkers(o.threads - 1);
+	GameBatch batch(o, results);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	pool.run(batch, o.games);
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	// sum in game order, so the totals are the same however the games were scheduled
+	vector<LevelOutcome> totals(o.levels);
+	long long ticks = 0;
+	for (vector<GameResult>::const_iterator g = results.begin(); g != results.end(); g++)
+	{
+		ticks += g->ticks;
+		for (int l = 0; l < o.levels; l++)
+		{
+			totals[l].games += g->levels[l].games;
+			totals[l].completions += g->levels[l].completions;
+			totals[l].completionTicks += g->levels[l].completionTicks;
+			totals[l].deaths += g->levels[l].deaths;
+			totals[l].score += g->levels[l].score;
+			totals[l].goodies += g->levels[l].goodies;
+		}
+	}
+
+	printf("games %ld  threads %d  seed %u  lives %d  ships %d  aliens %d  weights %d/%d/%d  collisions %s\n", o.games, o.threads, o.seed,
+		o.lives, o.tuning.alienShipsToBeDestroyed, o.tuning.maxAliensOnScreen, o.tuning.smallgonWeight, o.tuning.smoregonWeight,
+		o.tuning.snagglegonWeight, o.collisionMode == COLLIDE_SWEEP ? "sweep" : "per-actor");
+	printf("level     games  completed  ticks/clear  deaths/game  score/game  goodies/game\n");
+	for (int l = 0; l < o.levels; l++)
+	{
+		const LevelOutcome& t = totals[l];
+		if (t.games == 0)
+			break;
+		printf("%5d  %8ld  %8.1f%%  %11.1f  %11.3f  %10.1f  %12.3f\n", l + 1, t.games, 100.0 * t.completions / t.games,
+			t.completions > 0 ? double(t.completionTicks) / t.completions : 0.0, double(t.deaths) / t.games,
+			double(t.score) / t.games, double(t.goodies) / t.games);
+	}
+	printf("ticks         %lld\n", ticks);
+	printf("seconds       %.3f\n", seconds);
+	printf("ticks/sec     %.0f\n", ticks / seconds);
+	return 0;
+}
@@ -0,0 +1,432 @@
+// microbench: times the hot-path primitives of Actor and StudentWorld one at a time, in the style of
+// Google Benchmark (without depending on it).
+//
+//   microbench [--filter TEXT] [--min-time SECONDS] [--csv]
+//
+// Each benchmark runs its body in batches of doubling size until a batch takes at least --min-time
+// (default .25) and reports the time per operation of that batch. --filter runs only the benchmarks
+// whose name contains TEXT. The default output is a table for people; --csv prints
+// "name,iterations,ns_per_op,actors" lines in a fixed order, so the results of two builds can be joined on
+// name and compared. actors is how many actors the timed loop cycled through (0 where that means nothing). Every world is seeded, so two builds are timed doing exactly the same work.
+//
+// Fixtures use the world's private steps directly through WorldBench, a friend of StudentWorld.
+#include "StudentWorld.h"
+#include "Actor.h"
+#include "CollisionKernel.h"
+#include "Headless.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+using namespace std;
+
+// what a benchmark body sees: how many operations to run, and a way to leave setup out of the timing
+class State
+{
+public:
+	State(long iterations) : m_iterations(iterations), m_elapsedNs(0), m_running(false), m_actors(0) {}
+
+	long iterations() const { return m_iterations; }
+	long long elapsedNs() const { return m_elapsedNs; }
+	int actors() const { return m_actors; }
+
+	void setActors(int n) { m_actors = n; }		// how many actors the timed loop cycles through, for the report
+
+	void resumeTiming()
+	{
+		m_running = true;
+		m_start = chrono::steady_clock::now();
+	}
+	void pauseTiming()
+	{
+		if (m_running)
+			m_elapsedNs += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_start).count();
+		m_running = false;
+	}
+
+private:
+	long m_iterations;
+	long long m_elapsedNs;
+	bool m_running;
+	chrono::steady_clock::time_point m_start;
+	int m_actors;
+};
+
+typedef void (*BenchFunction)(State& state, int arg);
+
+struct Benchmark
+{
+	const char* name;
+	BenchFunction run;
+	int arg;
+};
+
+// keeps results alive so the compiler cannot drop the work that produced them
+static volatile long s_sink;
+
+class WorldBench
+{
+public:
+	static bool isCollision(const StudentWorld& w, const Actor* a, const Actor* b) { return w.isCollision(a, b); }
+	static void deleteDeadActors(StudentWorld& w) { w.deleteDeadActors(); }
+	static int decideShipToAdd(StudentWorld& w) { return w.decideShipToAdd(); }
+	static void updateStatusText(StudentWorld& w) { w.updateStatusText(); }
+	static void refreshLineOfFire(StudentWorld& w) { w.refreshLineOfFire(); }
+	static Actor* createActor(StudentWorld& w, int kind, double x, double y) { return w.createActor(kind, x, y); }
+
+	// what the end of a tick does: commits spawns, flushes sounds, deletes the dead; true if there was any of it
+	static bool settle(StudentWorld& w)
+	{
+		bool spawned = w.commitSpawns();
+		bool sounded = w.m_sounds.size() != 0;
+		w.flushSounds();
+		size_t live = w.actorPool().liveObjects();
+		w.deleteDeadActors();
+		return spawned || sounded || w.actorPool().liveObjects() != live;
+	}
+};
+
+// a level 1 world with its stars and NachenBlaster, seeded so every build gets the same one
+static void startWorld(StudentWorld& world)
+{
+	world.setSeed(1);
+	world.advanceToNextLevel();
+	world.init();
+}
+
+// n aliens and n NachenBlaster cabbages scattered over the screen, all in the collision grids
+static void populate(StudentWorld& world, int n, vector<Actor*>& aliens, vector<Actor*>& cabbages)
+{
+	for (int i = 0; i < n; i++)
+	{
+		double x = world.randInt(0, VIEW_WIDTH - 1);
+		double y = world.randInt(0, VIEW_HEIGHT - 1);
+		Actor* a = WorldBench::createActor(world, SPAWN_SMALLGON, x, y);
+		world.addActor(a);
+		aliens.push_back(a);
+	}
+	for (int i = 0; i < n; i++)
+	{
+		double x = world.randInt(0, VIEW_WIDTH - 1);
+		double y = world.randInt(0, VIEW_HEIGHT - 1);
+		Actor* c = new (world.actorPool()) Cabbage(&world, x, y);
+		world.addActor(c);
+		cabbages.push_back(c);
+	}
+}
+
+// rows of aliens (radius 12) alternating with rows of cabbages (radius 4) 13 pixels apart, so no alien and
+// cabbage are ever closer than the 12 pixels it takes to collide, yet every alien has cabbages in the grid
+// cells around it. Aliens never collide with each other, so they can share a row as densely as it takes.
+// They keep clear of the NachenBlaster at (0, 128) by starting at x = 24.
+const int APART_ROWS = 10;
+const int APART_ROW_SPACING = 26;
+
+static void populateApart(StudentWorld& world, int n, vector<Actor*>& aliens, vector<Actor*>& cabbages)
+{
+	for (int i = 0; i < n; i++)
+	{
+		double x = 24 + (i / APART_ROWS * 7) % (VIEW_WIDTH - 24);
+		double y = 6 + (i % APART_ROWS) * APART_ROW_SPACING;
+		Actor* a = WorldBench::createActor(world, SPAWN_SMALLGON, x, y);
+		world.addActor(a);
+		aliens.push_back(a);
+	}
+	for (int i = 0; i < n; i++)
+	{
+		double x = (i / APART_ROWS * 5) % VIEW_WIDTH;
+		double y = 6 + (i % APART_ROWS) * APART_ROW_SPACING + APART_ROW_SPACING / 2;
+		Actor* c = new (world.actorPool()) Cabbage(&world, x, y);
+		world.addActor(c);
+		cabbages.push_back(c);
+	}
+}
+
+// checkCollision for each alien in turn among arg aliens and arg cabbages, laid out by populateApart so
+// that none of them touch: every call does the same lookups, finds candidates and hits nothing. That the
+// timed calls changed nothing is checked afterwards.
+static void benchCheckCollision(State& state, int arg)
+{
+	StudentWorld world("");
+	startWorld(world);
+	vector<Actor*> aliens, cabbages;
+	populateApart(world, arg, aliens, cabbages);
+	state.setActors(aliens.size());
+
+	unsigned int score = world.getScore();
+	size_t live = world.actorPool().liveObjects();
+	size_t heap = world.actorPool().heapAllocations();
+
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+		world.checkCollision(aliens[i % aliens.size()]);
+	state.pauseTiming();
+
+	if (WorldBench::settle(world) || world.getScore() != score
+		|| world.actorPool().liveObjects() != live || world.actorPool().heapAllocations() != heap)
+	{
+		fprintf(stderr, "microbench: checkCollision/%d changed the world it was timing\n", arg);
+		exit(1);
+	}
+	world.cleanUp();
+}
+
+static void benchIsCollision(State& state, int /*arg*/)
+{
+	StudentWorld world("");
+	startWorld(world);
+	vector<Actor*> aliens, cabbages;
+	populate(world, 64, aliens, cabbages);
+
+	long hits = 0;
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+		hits += WorldBench::isCollision(world, aliens[i & 63], cabbages[(i >> 6) & 63]);
+	state.pauseTiming();
+	s_sink = hits;
+	world.cleanUp();
+}
+
+static void benchCirclesCollide(State& state, int /*arg*/)
+{
+	// a 64 x 64 table of positions, half of the pairs close enough to touch
+	double xs[64], ys[64];
+	for (int i = 0; i < 64; i++)
+	{
+		xs[i] = (i * 37) % 256;
+		ys[i] = (i * 11) % 256;
+	}
+	long hits = 0;
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+		hits += circlesCollide(xs[i & 63], ys[i & 63], 12, xs[(i >> 6) & 63], ys[(i >> 6) & 63], 8);
+	state.pauseTiming();
+	s_sink = hits;
+}
+
+static void benchPlayerInLineOfFire(State& state, int /*arg*/)
+{
+	StudentWorld world("");
+	startWorld(world);
+	vector<Actor*> aliens, cabbages;
+	populate(world, 64, aliens, cabbages);
+
+	long inLine = 0;
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+		inLine += world.playerInLineOfFire(aliens[i & 63]);
+	state.pauseTiming();
+	s_sink = inLine;
+	world.cleanUp();
+}
+
+// asking the world for every alien that could shoot. With arg > 0 there are arg aliens and every query
+// follows a refresh, so it builds the sorted index as the first query of a tick does; with arg < 0 there are
+// -arg aliens and only the first query builds it, so the rest time the range query alone
+static void benchAliensInLineOfFire(State& state, int arg)
+{
+	StudentWorld world("");
+	startWorld(world);
+	vector<Actor*> aliens, cabbages, shooters;
+	populate(world, arg < 0 ? -arg : arg, aliens, cabbages);
+	WorldBench::refreshLineOfFire(world);
+
+	long found = 0;
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+	{
+		if (arg > 0)
+			WorldBench::refreshLineOfFire(world);
+		found += world.aliensInLineOfFire(shooters);
+	}
+	state.pauseTiming();
+	s_sink = found;
+	world.cleanUp();
+}
+
+// deleteDeadActors over 256 aliens and 256 cabbages (plus the stars), arg percent of them dead
+static void benchDeleteDeadActors(State& state, int arg)
+{
+	StudentWorld world("");
+	startWorld(world);
+	for (long i = 0; i < state.iterations(); i++)
+	{
+		vector<Actor*> aliens, cabbages;
+		populate(world, 256, aliens, cabbages);
+		for (size_t j = 0; j < aliens.size(); j++)
+		{
+			if (static_cast<int>(j % 100) < arg)
+			{
+				aliens[j]->setDead();
+				cabbages[j]->setDead();
+			}
+		}
+
+		state.resumeTiming();
+		WorldBench::deleteDeadActors(world);
+		state.pauseTiming();
+
+		// put the world back the way it was for the next operation
+		for (size_t j = 0; j < aliens.size(); j++)
+		{
+			if (static_cast<int>(j % 100) >= arg)
+			{
+				aliens[j]->setDead();
+				cabbages[j]->setDead();
+			}
+		}
+		WorldBench::deleteDeadActors(world);
+	}
+	world.cleanUp();
+}
+
+static void benchDecideShipToAdd(State& state, int /*arg*/)
+{
+	StudentWorld world("");
+	startWorld(world);
+	long ships = 0;
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+		ships += WorldBench::decideShipToAdd(world);
+	state.pauseTiming();
+	s_sink = ships;
+	world.cleanUp();
+}
+
+// arg 0: nothing on the status line changes; arg 1: the score changes every time
+static void benchUpdateStatusText(State& state, int arg)
+{
+	StudentWorld world("");
+	startWorld(world);
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+	{
+		if (arg)
+			world.increaseScore(10);
+		WorldBench::updateStatusText(world);
+	}
+	state.pauseTiming();
+	world.cleanUp();
+}
+
+// new and delete of one SPAWN_* kind from the world's pool
+static void benchNewDelete(State& state, int arg)
+{
+	StudentWorld world("");
+	startWorld(world);
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+		delete WorldBench::createActor(world, arg, 128, 128);
+	state.pauseTiming();
+	world.cleanUp();
+}
+
+static void benchNewDeleteNachenBlaster(State& state, int /*arg*/)
+{
+	StudentWorld world("");
+	startWorld(world);
+	state.resumeTiming();
+	for (long i = 0; i < state.iterations(); i++)
+		delete new NachenBlaster(&world);
+	state.pauseTiming();
+	world.cleanUp();
+}
+
+static const Benchmark BENCHMARKS[] =
+{
+	{ "checkCollision/16", benchCheckCollision, 16 },
+	{ "checkCollision/64", benchCheckCollision, 64 },
+	{ "checkCollision/256", benchCheckCollision, 256 },
+	{ "checkCollision/1024", benchCheckCollision, 1024 },
+	{ "isCollision", benchIsCollision, 0 },
+	{ "circlesCollide", benchCirclesCollide, 0 },
+	{ "playerInLineOfFire", benchPlayerInLineOfFire, 0 },
+	{ "aliensInLineOfFire/16", benchAliensInLineOfFire, 16 },
+	{ "aliensInLineOfFire/256", benchAliensInLineOfFire, 256 },
+	{ "aliensInLineOfFire/256/indexed", benchAliensInLineOfFire, -256 },
+	{ "deleteDeadActors/0", benchDeleteDeadActors, 0 },
+	{ "deleteDeadActors/10", benchDeleteDeadActors, 10 },
+	{ "deleteDeadActors/50", benchDeleteDeadActors, 50 },
+	{ "deleteDeadActors/100", benchDeleteDeadActors, 100 },
+	{ "decideShipToAdd", benchDecideShipToAdd, 0 },
+	{ "updateStatusText/unchanged", benchUpdateStatusText, 0 },
+	{ "updateStatusText/score", benchUpdateStatusText, 1 },
+	{ "newDelete/Cabbage", benchNewDelete, SPAWN_CABBAGE },
+	{ "newDelete/Torpedo", benchNewDelete, SPAWN_NB_TORPEDO },
+	{ "newDelete/Turnip", benchNewDelete, SPAWN_TURNIP },
+	{ "newDelete/Explosion", benchNewDelete, SPAWN_EXPLOSION },
+	{ "newDelete/RepairGoodie", benchNewDelete, SPAWN_REPAIR_GOODIE },
+	{ "newDelete/TorpedoGoodie", benchNewDelete, SPAWN_TORPEDO_GOODIE },
+	{ "newDelete/ExtraLifeGoodie", benchNewDelete, SPAWN_EXTRA_LIFE_GOODIE },
+	{ "newDelete/Smallgon", benchNewDelete, SPAWN_SMALLGON },
+	{ "newDelete/Smoregon", benchNewDelete, SPAWN_SMOREGON },
+	{ "newDelete/Snagglegon", benchNewDelete, SPAWN_SNAGGLEGON },
+	{ "newDelete/NachenBlaster", benchNewDeleteNachenBlaster, 0 },
+};
+const int NUM_BENCHMARKS = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+
+static void usage()
+{
+	fprintf(stderr, "usage: microbench [--filter TEXT] [--min-time SECONDS] [--csv]\n");
+	exit(2);
+}
+
+int main(int argc, char* argv[])
+{
+	const char* filter = "";
+	double minTime = .25;
+	bool csv = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--csv") == 0)
+			csv = true;
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+			filter = argv[++i];
+		else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+			minTime = atof(argv[++i]);
+		else
+			usage();
+	}
+
+	HeadlessContext context;		// no input, sounds only counted
+	bindHeadlessContext(&context);
+
+	if (csv)
+		printf("name,iterations,ns_per_op,actors\n");
+	else
+	{
+		printf("%-32s %14s %14s %8s\n", "Benchmark", "Time", "Iterations", "Actors");
+		printf("%s\n", string(71, '-').c_str());
+	}
+	for (int b = 0; b < NUM_BENCHMARKS; b++)
+	{
+		const char* name = BENCHMARKS[b].name;
+		if (strstr(name, filter) == nullptr)
+			continue;
+
+		long iterations = 1;
+		double nsPerOp;
+		int actors;
+		for (;;)
+		{
+			State state(iterations);
+			BENCHMARKS[b].run(state, BENCHMARKS[b].arg);
+			nsPerOp = double(state.elapsedNs()) / iterations;
+			actors = state.actors();
+			if (state.elapsedNs() >= minTime * 1e9 || iterations >= 1000000000L)
+				break;
+			iterations *= 2;
+		}
+
+		if (csv)
+			printf("%s,%ld,%.2f,%d\n", name, iterations, nsPerOp, actors);
+		else if (actors > 0)
+			printf("%-32s %11.1f ns %14ld %8d\n", name, nsPerOp, iterations, actors);
+		else
+			printf("%-32s %11.1f ns %14ld\n", name, nsPerOp, iterations);
+		fflush(stdout);
+	}
+	return 0;
+}
@@ -0,0 +1,217 @@
+// replay: records a headless game's input, or replays a recording and checks it still plays out the same.
+//
+//   replay record FILE [--seed S] [--level L] [--ticks N] [--sweep 1] [--next-tick 1] [--threads T]
+//   replay play FILE [--repeat R]
+//
+// record plays a RandomPilot game (until game over or N ticks, default 20000) and writes the seed, keys and
+// per-tick state hashes to FILE. play rebuilds the world from FILE, feeds the keys back in as fast as it
+// can and compares every tick's state hash with the recording; it stops at the first tick that differs
+// and exits with status 1. --repeat plays the file R times, for timing. --threads records with the parallel
+// update on T threads (with --sweep 1); the file only says whether it was on, since any T plays the same game.
+// Recordings made by the real game (run it with NACHENBLASTER_RECORD=FILE) play back the same way. play refuses
+// a file recorded with a different alien table than the one NACHENBLASTER_ALIENS gives it now.
+#include "StudentWorld.h"
+#include "InputLog.h"
+#include "Headless.h"
+#include "Pilot.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+// feeds a recording's keys back in the order the world read them
+class ReplayInput : public InputSource
+{
+public:
+	ReplayInput(const InputLog& log) : m_log(log), m_next(0) {}
+	virtual bool getKey(int& value)
+	{
+		if (m_next >= m_log.numKeys())
+			return false;
+		int key = m_log.key(m_next++);
+		if (key == NO_KEY)
+			return false;
+		value = key;
+		return true;
+	}
+
+private:
+	const InputLog& m_log;
+	size_t m_next;
+};
+
+static void usage()
+{
+	fprintf(stderr, "usage: replay record FILE [--seed S] [--level L] [--ticks N] [--sweep 1] [--next-tick 1] [--threads T]\n"
+		"       replay play FILE [--repeat R]\n");
+	exit(2);
+}
+
+// what the framework does with move()'s result: next life or next level, until the lives run out
+static bool afterTick(StudentWorld& world, int status)
+{
+	if (status == GWSTATUS_PLAYER_DIED)
+	{
+		if (world.getLives() == 0)
+			return false;
+		world.cleanUp();
+		world.init();
+	}
+	else if (status == GWSTATUS_FINISHED_LEVEL)
+	{
+		world.cleanUp();
+		world.advanceToNextLevel();
+		world.init();
+	}
+	return true;
+}
+
+static void setUp(StudentWorld& world, const InputLog::Setup& setup)
+{
+	world.setSeed(setup.seed);
+	world.setTuning(setup.tuning);
+	world.setCollisionMode(setup.collisionMode);
+	world.setSpawnTiming(setup.spawnTiming);
+	world.setUpdateThreads(setup.parallelUpdate ? 1 : 0);		// any thread count plays the same game
+	while (world.getLevel() < setup.level)
+		world.advanceToNextLevel();
+	while (world.getLives() < setup.lives)
+		world.incLives();
+	while (world.getLives() > setup.lives)
+		world.decLives();
+}
+
+static int record(const char* path, int argc, char* argv[])
+{
+	InputLog::Setup setup;
+	setup.seed = 1;
+	setup.level = 1;
+	setup.lives = 3;
+	long ticks = 20000;
+	long threads = 0;
+	for (int i = 0; i < argc; i += 2)
+	{
+		if (i + 1 >= argc)
+			usage();
+		long v = atol(argv[i + 1]);
+		if (strcmp(argv[i], "--seed") == 0)
+			setup.seed = v;
+		else if (strcmp(argv[i], "--level") == 0)
+			setup.level = v;
+		else if (strcmp(argv[i], "--ticks") == 0)
+			ticks = v;
+		else if (strcmp(argv[i], "--sweep") == 0)
+			setup.collisionMode = v ? COLLIDE_SWEEP : COLLIDE_PER_ACTOR;
+		else if (strcmp(argv[i], "--next-tick") == 0)
+			setup.spawnTiming = v ? SPAWN_ACTS_NEXT_TICK : SPAWN_ACTS_SAME_TICK;
+		else if (strcmp(argv[i], "--threads") == 0)
+		{
+			threads = v;
+			setup.parallelUpdate = v > 0;
+		}
+		else
+			usage();
+	}
+
+	RandomPilot pilot(setup.seed ^ 0x9e3779b97f4a7c15ULL);
+	HeadlessContext context;
+	context.input = &pilot;
+	bindHeadlessContext(&context);
+
+	StudentWorld world("");
+	setUp(world, setup);
+	world.setUpdateThreads(threads);
+	InputLog log;
+	world.recordInput(&log);
+	world.init();
+	for (long t = 0; t < ticks && afterTick(world, world.move()); t++)
+		;
+
+	if (!log.save(path))
+	{
+		fprintf(stderr, "replay: cannot write %s\n", path);
+		return 1;
+	}
+	printf("recorded %lu ticks, %lu keys, score %u\n", (unsigned long)log.numTicks(), (unsigned long)log.numKeys(), world.getScore());
+	return 0;
+}
+
+static int play(const char* path, int argc, char* argv[])
+{
+	long repeat = 1;
+	for (int i = 0; i < argc; i += 2)
+	{
+		if (i + 1 >= argc)
+			usage();
+		if (strcmp(argv[i], "--repeat") == 0)
+			repeat = atol(argv[i + 1]);
+		else
+			usage();
+	}
+
+	InputLog log;
+	if (!log.load(path))
+	{
+		fprintf(stderr, "replay: %s is not a recording\n", path);
+		return 1;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	long long ticks = 0;
+	size_t replayed = 0;		// ticks of the last repeat
+	unsigned int score = 0;
+	for (long r = 0; r < repeat; r++)
+	{
+		ReplayInput input(log);
+		HeadlessContext context;
+		context.input = &input;
+		bindHeadlessContext(&context);
+
+		StudentWorld world("");
+		if (world.alienArchetypesHash() != log.setup().archetypesHash)
+		{
+			fprintf(stderr, "replay: %s was recorded with a different alien table; set NACHENBLASTER_ALIENS to the one it used\n", path);
+			return 1;
+		}
+		setUp(world, log.setup());
+		world.init();
+		replayed = 0;
+		for (size_t t = 0; t < log.numTicks(); t++)
+		{
+			int status = world.move();
+			if (world.stateHash() != log.tickHash(t))
+			{
+				fprintf(stderr, "replay: %s diverges at tick %lu\n", path, (unsigned long)t);
+				return 1;
+			}
+			ticks++;
+			replayed++;
+			if (!afterTick(world, status))
+				break;
+		}
+		score = world.getScore();
+		if (replayed < log.numTicks())
+		{
+			fprintf(stderr, "replay: %s ends in game over at tick %lu of %lu recorded\n", path,
+				(unsigned long)replayed, (unsigned long)log.numTicks());
+			return 1;
+		}
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	printf("%s: %lu ticks match, score %u\n", path, (unsigned long)replayed, score);
+	printf("ticks/sec     %.0f\n", ticks / seconds);
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+		usage();
+	if (strcmp(argv[1], "record") == 0)
+		return record(argv[2], argc - 3, argv + 3);
+	if (strcmp(argv[1], "play") == 0)
+		return play(argv[2], argc - 3, argv + 3);
+	usage();
+}
@@ -0,0 +1,242 @@
+// tickbench: runs a headless StudentWorld for a fixed number of ticks and reports tick cost.
+//
+//   tickbench [--level L] [--ticks N] [--warmup W] [--seed S] [--stars K] [--aliens M] [--ships T] [--sweep 1]
+//             [--threads N] [--next-tick 1] [--render 1] [--trace PREFIX]
+//
+// --stars and --aliens raise the number of stars created by init() and the number of aliens allowed on
+// screen, --ships raises the number of kills needed to finish a level (so dense runs do not keep
+// restarting). --sweep 1 switches the world to the COLLIDE_SWEEP collision phase. When the player dies
+// or finishes the level the world is cleaned up and re-initialized at the same level, like the framework
+// does between lives; that time is not counted as tick time. --threads N (with --sweep 1) uses the
+// parallel actor update on N threads. --next-tick 1 holds spawned actors back until the next tick
+// (SPAWN_ACTS_NEXT_TICK) instead of letting them act in the tick they were spawned. --render 1 has every
+// tick end by building the sorted render list, as it would for a backend that draws from it.
+//
+// --trace writes the measured ticks' counters and phase times to PREFIX.csv and PREFIX.json (Chrome
+// trace-event format), the last TICK_TRACE_CAPACITY of them if there are more. It needs a build with
+// -DINSTRUMENT_TICKS.
+#include "StudentWorld.h"
+#include "Headless.h"
+#include "Pilot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+using namespace std;
+
+// count every heap allocation so steady-state ticks can be shown to allocate nothing
+static unsigned long long s_allocations = 0;
+
+void* operator new(size_t size)
+{
+	s_allocations++;
+	void* p = malloc(size == 0 ? 1 : size);
+	if (p == nullptr)
+		throw bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+struct Options
+{
+	int level;
+	long ticks;
+	long warmup;
+	unsigned int seed;
+	int collisionMode;
+	int threads;
+	int spawnTiming;
+	bool render;
+	const char* tracePrefix;		// nullptr for no trace
+	WorldTuning tuning;
+};
+
+static void usage()
+{
+	fprintf(stderr, "usage: tickbench [--level L] [--ticks N] [--warmup W] [--seed S] [--stars K] [--aliens M] [--ships T] [--sweep 1] [--threads N] [--next-tick 1] [--render 1] [--trace PREFIX]\n");
+	exit(2);
+}
+
+static Options parseOptions(int argc, char* argv[])
+{
+	Options o;
+	o.level = 1;
+	o.ticks = 100000;
+	o.warmup = 1000;
+	o.seed = 1;
+	o.collisionMode = COLLIDE_PER_ACTOR;
+	o.threads = 0;
+	o.spawnTiming = SPAWN_ACTS_SAME_TICK;
+	o.render = false;
+	o.tracePrefix = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+			usage();
+		long v = atol(argv[i + 1]);
+		if (strcmp(argv[i], "--level") == 0)
+			o.level = v;
+		else if (strcmp(argv[i], "--ticks") == 0)
+			o.ticks = v;
+		else if (strcmp(argv[i], "--warmup") == 0)
+			o.warmup = v;
+		else if (strcmp(argv[i], "--seed") == 0)
+			o.seed = v;
+		else if (strcmp(argv[i], "--stars") == 0)
+			o.tuning.initialStars = v;
+		else if (strcmp(argv[i], "--aliens") == 0)
+			o.tuning.maxAliensOnScreen = v;
+		else if (strcmp(argv[i], "--ships") == 0)
+			o.tuning.alienShipsToBeDestroyed = v;
+		else if (strcmp(argv[i], "--sweep") == 0)
+			o.collisionMode = v ? COLLIDE_SWEEP : COLLIDE_PER_ACTOR;
+		else if (strcmp(argv[i], "--threads") == 0)
+			o.threads = v;
+		else if (strcmp(argv[i], "--next-tick") == 0)
+			o.spawnTiming = v ? SPAWN_ACTS_NEXT_TICK : SPAWN_ACTS_SAME_TICK;
+		else if (strcmp(argv[i], "--render") == 0)
+			o.render = v != 0;
+		else if (strcmp(argv[i], "--trace") == 0)
+			o.tracePrefix = argv[i + 1];
+		else
+			usage();
+		i++;
+	}
+	if (o.level < 1 || o.ticks < 1 || o.warmup < 0)
+		usage();
+#ifndef INSTRUMENT_TICKS
+	if (o.tracePrefix != nullptr)
+	{
+		fprintf(stderr, "tickbench: --trace needs a build with -DINSTRUMENT_TICKS\n");
+		exit(2);
+	}
+#endif
+	return o;
+}
+
+int main(int argc, char* argv[])
+{
+	Options o = parseOptions(argc, argv);
+
+	RandomPilot pilot(o.seed ^ 0x9e3779b97f4a7c15ULL);		// keep the pilot's sequence apart from the world's
+	HeadlessContext context;
+	context.input = &pilot;
+	bindHeadlessContext(&context);
+
+	StudentWorld world("");
+	world.setSeed(o.seed);
+	for (int i = 0; i < o.level; i++)
+		world.advanceToNextLevel();
+	world.setTuning(o.tuning);
+	world.setCollisionMode(o.collisionMode);
+	world.setUpdateThreads(o.threads);
+	world.setSpawnTiming(o.spawnTiming);
+	world.setBuildRenderList(o.render);
+	world.init();
+
+	vector<long long> tickNs;
+	tickNs.reserve(o.ticks);
+	long deaths = 0;
+	long levelsFinished = 0;
+	double actorSum = 0;
+	unsigned long long allocationsBefore = 0;
+	unsigned long statusTextsBefore = 0;
+
+	for (long t = 0; t < o.warmup + o.ticks; t++)
+	{
+		if (t == o.warmup)
+		{
+			allocationsBefore = s_allocations;
+			statusTextsBefore = world.statusTextsSent();
+#ifdef INSTRUMENT_TICKS
+			world.tickTrace().clear();
+#endif
+		}
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		int status = world.move();
+		chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+		if (t >= o.warmup)
+		{
+			tickNs.push_back(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+			actorSum += world.numActors();
+		}
+
+		if (status != GWSTATUS_CONTINUE_GAME)
+		{
+			if (status == GWSTATUS_PLAYER_DIED)
+			{
+				deaths++;
+				if (world.getLives() == 0)
+					world.incLives();		// keep going; the benchmark never ends the game
+			}
+			else
+				levelsFinished++;
+			unsigned long long allocationsBeforeRestart = s_allocations;
+			unsigned long statusTextsBeforeRestart = world.statusTextsSent();
+			world.cleanUp();
+			world.init();
+			allocationsBefore += s_allocations - allocationsBeforeRestart;		// restarts are not tick work
+			statusTextsBefore += world.statusTextsSent() - statusTextsBeforeRestart;
+		}
+	}
+	unsigned long long tickAllocations = s_allocations - allocationsBefore;
+
+	// the framework's setGameStatText takes a std::string by value, so every change to the status line costs
+	// what building that string costs; measure it once and count it apart from the rest of the tick's work
+	unsigned long long probeBefore = s_allocations;
+	{
+		string probe(world.statusText());
+	}
+	unsigned long long allocationsPerStatusText = s_allocations - probeBefore;
+	unsigned long long statusTextAllocations = (world.statusTextsSent() - statusTextsBefore) * allocationsPerStatusText;
+
+#ifdef INSTRUMENT_TICKS
+	if (o.tracePrefix != nullptr)
+	{
+		string prefix = o.tracePrefix;
+		if (!world.tickTrace().writeCsv(prefix + ".csv") || !world.tickTrace().writeChromeTrace(prefix + ".json"))
+		{
+			fprintf(stderr, "tickbench: cannot write %s.csv/.json\n", o.tracePrefix);
+			return 1;
+		}
+	}
+#endif
+
+	long long total = 0;
+	for (vector<long long>::const_iterator p = tickNs.begin(); p != tickNs.end(); p++)
+		total += *p;
+	sort(tickNs.begin(), tickNs.end());
+	long n = tickNs.size();
+	double nsPerTick = double(total) / n;
+
+	printf("level %d  ticks %ld  warmup %ld  seed %u  stars %d  aliens %d  ships %d  collisions %s  threads %d  spawns act %s  render %s\n", o.level, o.ticks, o.warmup, o.seed,
+		o.tuning.initialStars, o.tuning.maxAliensOnScreen, o.tuning.alienShipsToBeDestroyed, o.collisionMode == COLLIDE_SWEEP ? "sweep" : "per-actor", o.threads,
+		o.spawnTiming == SPAWN_ACTS_NEXT_TICK ? "next tick" : "same tick", o.render ? "on" : "off");
+	printf("ns/tick       %.1f\n", nsPerTick);
+	printf("p50 ns        %lld\n", tickNs[n / 2]);
+	printf("p99 ns        %lld\n", tickNs[min(n - 1, n * 99 / 100)]);
+	printf("ticks/sec     %.0f\n", 1e9 / nsPerTick);
+	printf("actors/tick   %.1f\n", actorSum / n);
+	printf("allocs/tick   %.3f  (status line %.3f, everything else %.3f: %llu in all)\n", double(tickAllocations) / n,
+		double(statusTextAllocations) / n, double(tickAllocations - statusTextAllocations) / n, tickAllocations - statusTextAllocations);
+	printf("deaths        %ld\n", deaths);
+	printf("levels done   %ld\n", levelsFinished);
+	printf("pool          %lu chunk allocations, %lu recycled\n", (unsigned long)world.actorPool().heapAllocations(),
+		(unsigned long)world.actorPool().recycledObjects());
+	return 0;
+}